@@ -0,0 +1,195 @@
+#ifndef BITGRID_HPP
+#define BITGRID_HPP
+
+#include "MortonOrder.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A BitGrid is a width x height grid of flags stored one bit per cell in a
+// single array of 64-bit words, so the whole grid is one heap allocation.
+// resize() and reset() clear the flags but keep the storage, so a
+// generator or solver that runs many times only allocates once.
+//
+// Cells are numbered row-major by default, which keeps a row in the same
+// cache line.  The morton layout numbers them in Z-order instead (see
+// MortonOrder.hpp), so vertical neighbours are near each other too.  The
+// storage then has to cover every number up to that of the last cell,
+// which grows with the square of the longer side: about three times the
+// cells for 1025x1025, but hundreds of times for a long thin grid.  So a
+// grid whose Z-order numbers would need more than four times its cells is
+// numbered row-major even when morton was asked for; getIndexLayout()
+// says which numbering is in use.
+class BitGrid
+{
+public:
+    enum class Layout { rowMajor, morton };
+
+    BitGrid();
+    BitGrid(int width, int height, Layout layout = Layout::rowMajor);
+
+    // resize() makes the grid width x height with every flag cleared.
+    void resize(int width, int height);
+
+    // setLayout() renumbers the cells, which clears every flag.
+    // getLayout() is the layout asked for and getIndexLayout() the one
+    // the current size actually uses.
+    Layout getLayout() const noexcept;
+    Layout getIndexLayout() const noexcept;
+    void setLayout(Layout layout);
+
+    // reset() clears every flag without changing the size.
+    void reset();
+
+    int getWidth() const noexcept;
+    int getHeight() const noexcept;
+
+    bool test(int x, int y) const noexcept;
+    void set(int x, int y) noexcept;
+    void clear(int x, int y) noexcept;
+
+    // testAndSet() sets the flag at (x, y) and returns what it was before.
+    bool testAndSet(int x, int y) noexcept;
+
+    // memoryBytes() is the size of the storage backing the grid.
+    std::size_t memoryBytes() const noexcept;
+
+    // index() is the number of cell (x, y) in the current layout, and
+    // testIndex() reads a flag by that number, so a caller can step to
+    // neighbours with MortonOrder's arithmetic instead of renumbering.
+    std::size_t index(int x, int y) const noexcept;
+    bool testIndex(std::size_t i) const noexcept;
+
+private:
+    int width;
+    int height;
+    Layout layout;
+    bool morton;
+    std::vector<std::uint64_t> words;
+};
+
+
+inline BitGrid::BitGrid()
+    : width{0}, height{0}, layout{Layout::rowMajor}, morton{false}
+{
+}
+
+
+inline BitGrid::BitGrid(int width, int height, Layout layout)
+    : BitGrid{}
+{
+    this->layout = layout;
+    resize(width, height);
+}
+
+
+inline void BitGrid::resize(int width, int height)
+{
+    this->width = width;
+    this->height = height;
+    std::size_t cells = static_cast<std::size_t>(width) * height;
+    morton = false;
+    if (layout == Layout::morton && cells > 0)
+    {
+        std::size_t numbers = MortonOrder::encode(width - 1, height - 1) + 1;
+        if (numbers <= 4 * cells)
+        {
+            morton = true;
+            cells = numbers;
+        }
+    }
+    words.assign((cells + 63) / 64, 0);
+}
+
+
+inline BitGrid::Layout BitGrid::getLayout() const noexcept
+{
+    return layout;
+}
+
+
+inline BitGrid::Layout BitGrid::getIndexLayout() const noexcept
+{
+    return morton ? Layout::morton : Layout::rowMajor;
+}
+
+
+inline void BitGrid::setLayout(Layout layout)
+{
+    this->layout = layout;
+    resize(width, height);
+}
+
+
+inline void BitGrid::reset()
+{
+    words.assign(words.size(), 0);
+}
+
+
+inline int BitGrid::getWidth() const noexcept
+{
+    return width;
+}
+
+
+inline int BitGrid::getHeight() const noexcept
+{
+    return height;
+}
+
+
+inline std::size_t BitGrid::index(int x, int y) const noexcept
+{
+    if (morton)
+    {
+        return MortonOrder::encode(x, y);
+    }
+    return static_cast<std::size_t>(y) * width + x;
+}
+
+
+inline bool BitGrid::testIndex(std::size_t i) const noexcept
+{
+    return (words[i >> 6] >> (i & 63)) & 1;
+}
+
+
+inline bool BitGrid::test(int x, int y) const noexcept
+{
+    return testIndex(index(x, y));
+}
+
+
+inline void BitGrid::set(int x, int y) noexcept
+{
+    std::size_t i = index(x, y);
+    words[i >> 6] |= std::uint64_t{1} << (i & 63);
+}
+
+
+inline void BitGrid::clear(int x, int y) noexcept
+{
+    std::size_t i = index(x, y);
+    words[i >> 6] &= ~(std::uint64_t{1} << (i & 63));
+}
+
+
+inline bool BitGrid::testAndSet(int x, int y) noexcept
+{
+    std::size_t i = index(x, y);
+    std::uint64_t bit = std::uint64_t{1} << (i & 63);
+    std::uint64_t& word = words[i >> 6];
+    bool wasSet = (word & bit) != 0;
+    word |= bit;
+    return wasSet;
+}
+
+
+inline std::size_t BitGrid::memoryBytes() const noexcept
+{
+    return words.capacity() * sizeof(std::uint64_t);
+}
+
+
+#endif
@@ -0,0 +1,137 @@
+// BitGrid_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks BitGrid's flags against a plain vector<bool> kept alongside.
+
+#include <gtest/gtest.h>
+#include "BitGrid.hpp"
+#include "MortonOrder.hpp"
+#include <cstdint>
+#include <vector>
+
+
+TEST(BitGrid_SanityCheckTests, startsCleared)
+{
+    BitGrid grid{70, 5};
+    EXPECT_EQ(70, grid.getWidth());
+    EXPECT_EQ(5, grid.getHeight());
+    for (int y = 0; y < 5; y++)
+    {
+        for (int x = 0; x < 70; x++)
+        {
+            EXPECT_FALSE(grid.test(x, y));
+        }
+    }
+}
+
+
+TEST(BitGrid_SanityCheckTests, flagsMatchAPlainGrid)
+{
+    const int width = 67;
+    const int height = 13;
+    BitGrid grid{width, height};
+    std::vector<bool> plain(width * height, false);
+    for (int i = 0; i < 2000; i++)
+    {
+        int x = (i * 31) % width;
+        int y = (i * 17) % height;
+        if (i % 3 == 2)
+        {
+            grid.clear(x, y);
+            plain[y * width + x] = false;
+        }
+        else
+        {
+            EXPECT_EQ(plain[y * width + x], grid.testAndSet(x, y));
+            plain[y * width + x] = true;
+        }
+    }
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            EXPECT_EQ(plain[y * width + x], grid.test(x, y));
+        }
+    }
+}
+
+
+TEST(BitGrid_SanityCheckTests, resetAndResizeClearEveryFlag)
+{
+    BitGrid grid{10, 10};
+    grid.set(9, 9);
+    grid.set(0, 0);
+    grid.reset();
+    EXPECT_FALSE(grid.test(9, 9));
+    EXPECT_FALSE(grid.test(0, 0));
+    EXPECT_EQ(10, grid.getWidth());
+
+    grid.set(3, 3);
+    grid.resize(4, 20);
+    EXPECT_EQ(4, grid.getWidth());
+    EXPECT_EQ(20, grid.getHeight());
+    EXPECT_FALSE(grid.test(3, 3));
+    grid.set(3, 19);
+    EXPECT_TRUE(grid.test(3, 19));
+}
+
+
+TEST(BitGrid_SanityCheckTests, usesOneBitPerCell)
+{
+    BitGrid grid{1000, 1000};
+    EXPECT_LE(grid.memoryBytes(), 1000 * 1000 / 8 + 8);
+}
+
+
+TEST(BitGrid_SanityCheckTests, mortonStepsMatchEncoding)
+{
+    for (std::uint32_t y = 1; y < 40; y += 3)
+    {
+        for (std::uint32_t x = 1; x < 40; x += 5)
+        {
+            std::uint64_t z = MortonOrder::encode(x, y);
+            EXPECT_EQ(MortonOrder::encode(x+1, y), MortonOrder::nextX(z));
+            EXPECT_EQ(MortonOrder::encode(x-1, y), MortonOrder::previousX(z));
+            EXPECT_EQ(MortonOrder::encode(x, y+1), MortonOrder::nextY(z));
+            EXPECT_EQ(MortonOrder::encode(x, y-1), MortonOrder::previousY(z));
+        }
+    }
+}
+
+
+TEST(BitGrid_SanityCheckTests, mortonFlagsMatchRowMajorFlags)
+{
+    BitGrid rowMajor{45, 33};
+    BitGrid morton{45, 33, BitGrid::Layout::morton};
+    ASSERT_EQ(BitGrid::Layout::morton, morton.getIndexLayout());
+    for (int i = 0; i < 45 * 33; i += 7)
+    {
+        rowMajor.set(i % 45, i / 45);
+        EXPECT_FALSE(morton.testAndSet(i % 45, i / 45));
+    }
+    for (int y = 0; y < 33; y++)
+    {
+        for (int x = 0; x < 45; x++)
+        {
+            EXPECT_EQ(rowMajor.test(x, y), morton.test(x, y));
+            EXPECT_EQ(morton.test(x, y), morton.testIndex(morton.index(x, y)));
+        }
+    }
+}
+
+
+// Z-order numbers for a long thin grid reach far past its cell count, so
+// it stays row-major.
+TEST(BitGrid_SanityCheckTests, mortonFallsBackForLongThinGrids)
+{
+    BitGrid grid{1000, 2, BitGrid::Layout::morton};
+    EXPECT_EQ(BitGrid::Layout::morton, grid.getLayout());
+    EXPECT_EQ(BitGrid::Layout::rowMajor, grid.getIndexLayout());
+    EXPECT_LE(grid.memoryBytes(), 2000u / 8 + 8);
+
+    grid.resize(1025, 1025);
+    EXPECT_EQ(BitGrid::Layout::morton, grid.getIndexLayout());
+    EXPECT_LE(grid.memoryBytes(), 4u * 1025 * 1025 / 8 + 8);
+}
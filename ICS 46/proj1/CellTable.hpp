@@ -0,0 +1,218 @@
+#ifndef CELLTABLE_HPP
+#define CELLTABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// A CellTable maps cell numbers (y * width + x) to small values for
+// searches that only remember a few cells, like the junctions Trémaux has
+// marked.  It is an open-addressing table with linear probing: the keys
+// are packed 32-bit cell numbers in one array and the values sit in
+// another, so an entry costs sizeof(Value) + 4 bytes plus the free slots
+// that keep probes short, with no allocation per entry the way
+// unordered_map has.  The table doubles once it is three quarters full,
+// and erase() shifts the following entries back instead of leaving
+// tombstones.
+//
+// Cell numbers have to be below 2^32 - 1, the number that marks a free
+// slot; check() throws for grids bigger than that.
+template <typename Value>
+class CellTable
+{
+public:
+    using Key = std::uint32_t;
+
+    // check() throws runtime_error if a width x height grid has cell
+    // numbers that don't fit in a Key.
+    static void check(int width, int height);
+
+    void clear();
+
+    std::size_t size() const noexcept;
+
+    // find() returns the value for key, or nullptr if it isn't there.
+    const Value* find(std::uint64_t key) const;
+    Value* find(std::uint64_t key);
+
+    // get() returns the value for key, adding it as Value{} first if it
+    // isn't there.
+    Value& get(std::uint64_t key);
+
+    void erase(std::uint64_t key);
+
+    // memoryBytes() is the size of the two arrays behind the table.
+    std::size_t memoryBytes() const noexcept;
+
+private:
+    static constexpr Key FREE = std::numeric_limits<Key>::max();
+    static constexpr std::size_t INITIAL_SLOTS = 64;
+
+    std::size_t home(Key key) const noexcept;
+    std::size_t slotOf(Key key) const;
+    void grow();
+
+private:
+    std::vector<Key> keys;
+    std::vector<Value> values;
+    std::size_t count = 0;
+    int shift = 64;
+};
+
+
+template <typename Value>
+void CellTable<Value>::check(int width, int height)
+{
+    if (static_cast<std::uint64_t>(width) * static_cast<std::uint64_t>(height) >= FREE)
+    {
+        throw std::runtime_error{"grid too big for a CellTable"};
+    }
+}
+
+
+template <typename Value>
+void CellTable<Value>::clear()
+{
+    keys.assign(keys.size(), FREE);
+    count = 0;
+}
+
+
+template <typename Value>
+std::size_t CellTable<Value>::size() const noexcept
+{
+    return count;
+}
+
+
+// Fibonacci hashing: the top bits of the key times 2^64 / phi.  The slot
+// count is always a power of two and shift is 64 minus its log.
+template <typename Value>
+std::size_t CellTable<Value>::home(Key key) const noexcept
+{
+    return static_cast<std::size_t>((key * std::uint64_t{0x9e3779b97f4a7c15}) >> shift);
+}
+
+
+// The slot holding key, or the free slot where it would go.
+template <typename Value>
+std::size_t CellTable<Value>::slotOf(Key key) const
+{
+    std::size_t mask = keys.size() - 1;
+    std::size_t slot = home(key);
+    while (keys[slot] != FREE && keys[slot] != key)
+    {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+
+template <typename Value>
+const Value* CellTable<Value>::find(std::uint64_t key) const
+{
+    if (count == 0)
+    {
+        return nullptr;
+    }
+    std::size_t slot = slotOf(static_cast<Key>(key));
+    return keys[slot] == FREE ? nullptr : &values[slot];
+}
+
+
+template <typename Value>
+Value* CellTable<Value>::find(std::uint64_t key)
+{
+    const CellTable& table = *this;
+    return const_cast<Value*>(table.find(key));
+}
+
+
+template <typename Value>
+Value& CellTable<Value>::get(std::uint64_t key)
+{
+    if (4 * (count + 1) > 3 * keys.size())
+    {
+        grow();
+    }
+    std::size_t slot = slotOf(static_cast<Key>(key));
+    if (keys[slot] == FREE)
+    {
+        keys[slot] = static_cast<Key>(key);
+        values[slot] = Value{};
+        count++;
+    }
+    return values[slot];
+}
+
+
+// Backward-shift deletion: after emptying the slot, any entry further
+// along the same run that could live in the hole is moved into it, so
+// every entry stays reachable from its home slot without tombstones.
+template <typename Value>
+void CellTable<Value>::erase(std::uint64_t key)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    std::size_t mask = keys.size() - 1;
+    std::size_t hole = slotOf(static_cast<Key>(key));
+    if (keys[hole] == FREE)
+    {
+        return;
+    }
+    count--;
+    for (std::size_t slot = (hole + 1) & mask; keys[slot] != FREE; slot = (slot + 1) & mask)
+    {
+        std::size_t wanted = home(keys[slot]);
+        if (((slot - wanted) & mask) >= ((slot - hole) & mask))
+        {
+            keys[hole] = keys[slot];
+            values[hole] = values[slot];
+            hole = slot;
+        }
+    }
+    keys[hole] = FREE;
+}
+
+
+template <typename Value>
+std::size_t CellTable<Value>::memoryBytes() const noexcept
+{
+    return keys.capacity() * sizeof(Key) + values.capacity() * sizeof(Value);
+}
+
+
+template <typename Value>
+void CellTable<Value>::grow()
+{
+    std::vector<Key> oldKeys;
+    std::vector<Value> oldValues;
+    oldKeys.swap(keys);
+    oldValues.swap(values);
+
+    std::size_t slots = oldKeys.empty() ? INITIAL_SLOTS : 2 * oldKeys.size();
+    keys.assign(slots, FREE);
+    values.assign(slots, Value{});
+    shift = 64;
+    for (std::size_t s = slots; s > 1; s >>= 1)
+    {
+        shift--;
+    }
+
+    for (std::size_t i = 0; i < oldKeys.size(); i++)
+    {
+        if (oldKeys[i] != FREE)
+        {
+            std::size_t slot = slotOf(oldKeys[i]);
+            keys[slot] = oldKeys[i];
+            values[slot] = oldValues[i];
+        }
+    }
+}
+
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef LOOPERASEDWALK_HPP
+#define LOOPERASEDWALK_HPP
+
+#include "Direction.hpp"
+#include "MazeSearch.hpp"
+#include "CellTable.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Turns a walk that wanders, doubles back and goes round loops into a
+// route that visits no cell twice: whenever the walk comes back to a cell
+// already on the route, everything after that cell is cut off.  Only the
+// cells on the current route are remembered, in a CellTable at about 8 to
+// 16 bytes a cell, so memory follows the route's length, not the maze's
+// size.  The maze must have fewer than 2^32 - 1 cells (see CellTable).
+class LoopErasedWalk
+{
+public:
+    void start(int x, int y, int width);
+    void move(Direction direction);
+
+    const std::vector<Direction>& route() const;
+
+    // memoryBytes() is what the route and its cell table take up.
+    std::size_t memoryBytes() const noexcept;
+
+private:
+    std::uint64_t key() const;
+
+private:
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    std::vector<Direction> moves;
+
+    // For each cell on the route, how many moves into it the cell is.
+    CellTable<std::uint32_t> onRoute;
+};
+
+
+inline void LoopErasedWalk::start(int x, int y, int width)
+{
+    this->x = x;
+    this->y = y;
+    this->width = width;
+    moves.clear();
+    onRoute.clear();
+    onRoute.get(key()) = 0;
+}
+
+
+inline std::uint64_t LoopErasedWalk::key() const
+{
+    return static_cast<std::uint64_t>(y) * width + x;
+}
+
+
+inline void LoopErasedWalk::move(Direction direction)
+{
+    MazeSearch::step(direction, x, y);
+    const std::uint32_t* found = onRoute.find(key());
+    if (found == nullptr)
+    {
+        moves.push_back(direction);
+        onRoute.get(key()) = static_cast<std::uint32_t>(moves.size());
+        return;
+    }
+
+    // Back on the route: walk the cut-off part backwards from the cell
+    // before this one, forgetting each cell, down to the kept prefix.
+    std::size_t keep = *found;
+    int cx = x;
+    int cy = y;
+    MazeSearch::step(MazeSearch::opposite(direction), cx, cy);
+    while (moves.size() > keep)
+    {
+        onRoute.erase(static_cast<std::uint64_t>(cy) * width + cx);
+        MazeSearch::step(MazeSearch::opposite(moves.back()), cx, cy);
+        moves.pop_back();
+    }
+}
+
+
+inline const std::vector<Direction>& LoopErasedWalk::route() const
+{
+    return moves;
+}
+
+
+inline std::size_t LoopErasedWalk::memoryBytes() const noexcept
+{
+    return moves.capacity() * sizeof(Direction) + onRoute.memoryBytes();
+}
+
+
+#endif
@@ -0,0 +1,149 @@
+#include "MazeBatchSolver.hpp"
+#include "myBFSMazeSolver.hpp"
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+using namespace std;
+
+namespace
+{
+    double percentile(const vector<double>& sorted, double fraction)
+    {
+        size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+        return sorted[min(index, sorted.size() - 1)];
+    }
+}
+
+MazeBatchSolver::MazeBatchSolver(unsigned int threadCount, SolverFactory factory)
+{
+    if (threadCount == 0)
+    {
+        threadCount = max(1u, thread::hardware_concurrency());
+    }
+    if (!factory)
+    {
+        factory = []() { return unique_ptr<MazeSolver>{new myBFSMazeSolver}; };
+    }
+    for (unsigned int i = 0; i < threadCount; i++)
+    {
+        solvers.push_back(factory());
+    }
+    for (unsigned int i = 0; i < threadCount; i++)
+    {
+        workers.emplace_back(&MazeBatchSolver::work, this, i);
+    }
+}
+
+MazeBatchSolver::~MazeBatchSolver()
+{
+    {
+        lock_guard<mutex> guard{lock};
+        stopping = true;
+    }
+    batchReady.notify_all();
+    for (thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+unsigned int MazeBatchSolver::getThreadCount() const
+{
+    return workers.size();
+}
+
+void MazeBatchSolver::solveAll(const vector<Job>& jobs)
+{
+    latencies.assign(jobs.size(), 0.0);
+    exception_ptr failure;
+    auto start = chrono::steady_clock::now();
+    {
+        unique_lock<mutex> guard{lock};
+        this->jobs = &jobs;
+        nextJob = 0;
+        busy = workers.size();
+        batch++;
+        batchReady.notify_all();
+        batchDone.wait(guard, [this]() { return busy == 0; });
+        this->jobs = nullptr;
+        failure = error;
+        error = nullptr;
+    }
+    if (failure)
+    {
+        rethrow_exception(failure);
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    statistics = MazeBatchStatistics{};
+    statistics.mazes = jobs.size();
+    statistics.seconds = seconds;
+    if (jobs.size() > 0)
+    {
+        vector<double> sorted = latencies;
+        sort(sorted.begin(), sorted.end());
+        statistics.mazesPerSecond = seconds > 0.0 ? jobs.size() / seconds : 0.0;
+        statistics.minLatency = sorted.front();
+        statistics.meanLatency = accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+        statistics.medianLatency = percentile(sorted, 0.5);
+        statistics.p95Latency = percentile(sorted, 0.95);
+        statistics.p99Latency = percentile(sorted, 0.99);
+        statistics.maxLatency = sorted.back();
+    }
+}
+
+MazeBatchStatistics MazeBatchSolver::getStatistics() const
+{
+    return statistics;
+}
+
+// Workers sleep until a new batch number appears, then take jobs off a
+// shared counter until it runs past the end.  Each job's latency goes into
+// its own slot of latencies[], so recording it needs no lock.  A solver
+// that throws only costs the batch that one maze; the exception is kept
+// for solveAll() to rethrow.
+void MazeBatchSolver::work(unsigned int worker)
+{
+    size_t seen = 0;
+    MazeSolver& solver = *solvers[worker];
+    while (true)
+    {
+        const vector<Job>* current = nullptr;
+        {
+            unique_lock<mutex> guard{lock};
+            batchReady.wait(guard, [&]() { return stopping || batch != seen; });
+            if (stopping)
+            {
+                return;
+            }
+            seen = batch;
+            current = jobs;
+        }
+
+        for (size_t i = nextJob++; i < current->size(); i = nextJob++)
+        {
+            auto start = chrono::steady_clock::now();
+            try
+            {
+                solver.solveMaze(*(*current)[i].first, *(*current)[i].second);
+            }
+            catch (...)
+            {
+                lock_guard<mutex> guard{lock};
+                if (!error)
+                {
+                    error = current_exception();
+                }
+            }
+            latencies[i] = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        }
+
+        {
+            lock_guard<mutex> guard{lock};
+            if (--busy == 0)
+            {
+                batchDone.notify_one();
+            }
+        }
+    }
+}
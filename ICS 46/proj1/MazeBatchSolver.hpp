@@ -0,0 +1,85 @@
+#ifndef MAZEBATCHSOLVER_HPP
+#define MAZEBATCHSOLVER_HPP
+
+#include "Maze.hpp"
+#include "MazeSolution.hpp"
+#include "MazeSolver.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// Latency figures are per maze, in seconds.
+struct MazeBatchStatistics
+{
+    size_t mazes = 0;
+    double seconds = 0.0;
+    double mazesPerSecond = 0.0;
+    double minLatency = 0.0;
+    double meanLatency = 0.0;
+    double medianLatency = 0.0;
+    double p95Latency = 0.0;
+    double p99Latency = 0.0;
+    double maxLatency = 0.0;
+};
+
+
+// A MazeBatchSolver solves many independent mazes on a fixed pool of
+// worker threads that lives as long as the MazeBatchSolver does.  Every
+// worker owns one solver made by the factory it was given and uses it for
+// every maze it picks up, so the solver's scratch buffers are allocated
+// once per worker and reused for each maze instead of once per maze.
+class MazeBatchSolver
+{
+public:
+    using SolverFactory = function<unique_ptr<MazeSolver>()>;
+    using Job = pair<const Maze*, MazeSolution*>;
+
+    // A thread count of 0 means one per hardware core.  The default
+    // factory makes breadth-first solvers.
+    explicit MazeBatchSolver(unsigned int threadCount = 0, SolverFactory factory = nullptr);
+    ~MazeBatchSolver();
+
+    MazeBatchSolver(const MazeBatchSolver&) = delete;
+    MazeBatchSolver& operator=(const MazeBatchSolver&) = delete;
+
+    unsigned int getThreadCount() const;
+
+    // solveAll() solves every maze into its solution and returns once all
+    // of them are done.  The mazes are only read.  If a solver throws, the
+    // other mazes are still solved and then the first exception thrown is
+    // rethrown here; the statistics are left as they were.
+    void solveAll(const vector<Job>& jobs);
+
+    // Figures for the last solveAll().
+    MazeBatchStatistics getStatistics() const;
+
+private:
+    void work(unsigned int worker);
+
+private:
+    vector<unique_ptr<MazeSolver>> solvers;
+    vector<thread> workers;
+
+    mutex lock;
+    condition_variable batchReady;
+    condition_variable batchDone;
+    size_t batch = 0;
+    unsigned int busy = 0;
+    bool stopping = false;
+
+    const vector<Job>* jobs = nullptr;
+    atomic<size_t> nextJob{0};
+    vector<double> latencies;
+    exception_ptr error;
+    MazeBatchStatistics statistics;
+};
+
+#endif
@@ -0,0 +1,99 @@
+// MazeBatchSolver_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks that a batch solves every maze on any number of workers and that
+// a solver throwing on one maze neither stops the others nor takes the
+// program down.  Run these under ThreadSanitizer too.
+
+#include <gtest/gtest.h>
+#include "MazeBatchSolver.hpp"
+#include "MazeSolutionFactory.hpp"
+#include "myBFSMazeSolver.hpp"
+#include "MazeSanityChecks.hpp"
+#include <stdexcept>
+#include <vector>
+
+using namespace MazeSanityChecks;
+
+
+namespace
+{
+    // Fails on any maze whose width is odd.
+    class PickySolver: public MazeSolver
+    {
+    public:
+        void solveMaze(const Maze& maze, MazeSolution& mazeSolution) override
+        {
+            if (maze.getWidth() % 2 == 1)
+            {
+                throw std::runtime_error{"odd maze"};
+            }
+            myBFSMazeSolver{}.solveMaze(maze, mazeSolution);
+        }
+    };
+
+
+    struct Batch
+    {
+        std::vector<std::unique_ptr<Maze>> mazes;
+        std::vector<std::unique_ptr<MazeSolution>> solutions;
+        std::vector<MazeBatchSolver::Job> jobs;
+
+        void add(std::unique_ptr<Maze> maze)
+        {
+            solutions.push_back(MazeSolutionFactory{}.createMazeSolution(maze->getWidth(), maze->getHeight()));
+            mazes.push_back(std::move(maze));
+            jobs.push_back({mazes.back().get(), solutions.back().get()});
+        }
+    };
+}
+
+
+TEST(MazeBatchSolver_SanityCheckTests, solvesEveryMaze)
+{
+    Batch batch;
+    for (uint64_t seed = 0; seed < 12; seed++)
+    {
+        batch.add(perfectMaze(seed));
+    }
+
+    for (unsigned int threads : {1u, 3u})
+    {
+        MazeBatchSolver solver{threads};
+        EXPECT_EQ(threads, solver.getThreadCount());
+        solver.solveAll(batch.jobs);
+        for (size_t i = 0; i < batch.jobs.size(); i++)
+        {
+            EXPECT_TRUE(solvedCorrectly(*batch.mazes[i], *batch.solutions[i])) << "maze " << i;
+        }
+        EXPECT_EQ(batch.jobs.size(), solver.getStatistics().mazes);
+        EXPECT_LE(solver.getStatistics().minLatency, solver.getStatistics().maxLatency);
+    }
+}
+
+
+TEST(MazeBatchSolver_SanityCheckTests, rethrowsAfterFinishingTheBatch)
+{
+    Batch batch;
+    for (int i = 0; i < 8; i++)
+    {
+        myMazeGenerator generator;
+        batch.add(generated(generator, 10 + i, 10));
+    }
+
+    MazeBatchSolver solver{3, []() { return std::unique_ptr<MazeSolver>{new PickySolver}; }};
+    EXPECT_THROW(solver.solveAll(batch.jobs), std::runtime_error);
+    for (size_t i = 0; i < batch.jobs.size(); i += 2)
+    {
+        EXPECT_TRUE(solvedCorrectly(*batch.mazes[i], *batch.solutions[i])) << "maze " << i;
+    }
+
+    // The pool is still usable afterwards.
+    Batch even;
+    myMazeGenerator generator;
+    even.add(generated(generator, 12, 12));
+    EXPECT_NO_THROW(solver.solveAll(even.jobs));
+    EXPECT_TRUE(solvedCorrectly(*even.mazes[0], *even.solutions[0]));
+}
@@ -0,0 +1,395 @@
+#include "MazeBitboard.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+constexpr char MazeBitboard::MAGIC[8];
+
+static_assert(sizeof(MazeBitboard::Header) == 64, "the bitboard header is 64 bytes on disk");
+
+namespace
+{
+    // Sets every bit of a row of words from bit width onward, which are
+    // the outer walls and the padding past the last cell.
+    void setPastWidth(uint64_t* words,size_t rowWords,int width)
+    {
+        for (size_t i = 0; i < rowWords; i++)
+        {
+            size_t first = i * 64;
+            if (first >= static_cast<size_t>(width))
+            {
+                words[i] = ~uint64_t{0};
+            }
+            else if (first + 64 > static_cast<size_t>(width))
+            {
+                words[i] |= ~uint64_t{0} << (width - first);
+            }
+        }
+    }
+}
+
+MazeBitboard::MazeBitboard()
+    : width{0}, height{0}, words{0}, rows{nullptr}, mapping{nullptr}, mappingBytes{0}
+{
+}
+
+MazeBitboard::MazeBitboard(int width,int height)
+    : MazeBitboard{}
+{
+    this->width = width;
+    this->height = height;
+    words = (static_cast<size_t>(width) + 63) / 64;
+    owned.assign(2 * words * height, ~uint64_t{0});
+    rows = owned.data();
+}
+
+MazeBitboard::~MazeBitboard()
+{
+    release();
+}
+
+MazeBitboard::MazeBitboard(MazeBitboard&& other) noexcept
+    : MazeBitboard{}
+{
+    *this = std::move(other);
+}
+
+MazeBitboard& MazeBitboard::operator=(MazeBitboard&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        width = other.width;
+        height = other.height;
+        words = other.words;
+        owned = std::move(other.owned);
+        rows = other.mapping != nullptr ? other.rows : owned.data();
+        mapping = other.mapping;
+        mappingBytes = other.mappingBytes;
+
+        other.width = other.height = 0;
+        other.words = 0;
+        other.rows = nullptr;
+        other.mapping = nullptr;
+        other.mappingBytes = 0;
+        other.owned.clear();
+    }
+    return *this;
+}
+
+void MazeBitboard::release() noexcept
+{
+    if (mapping != nullptr)
+    {
+        munmap(mapping, mappingBytes);
+        mapping = nullptr;
+        mappingBytes = 0;
+    }
+}
+
+MazeBitboard MazeBitboard::fromMaze(const Maze& maze)
+{
+    MazeBitboard bitboard{maze.getWidth(), maze.getHeight()};
+    for (int y = 0; y < bitboard.height; y++)
+    {
+        uint64_t* right = bitboard.rightWalls(y);
+        uint64_t* down = bitboard.downWalls(y);
+        fill(right, right + bitboard.words, 0);
+        fill(down, down + bitboard.words, 0);
+        for (int x = 0; x < bitboard.width; x++)
+        {
+            uint64_t bit = uint64_t{1} << (x & 63);
+            if (x+1 < bitboard.width && maze.wallExists(x,y,Direction::right))
+            {
+                right[x >> 6] |= bit;
+            }
+            if (y+1 < bitboard.height && maze.wallExists(x,y,Direction::down))
+            {
+                down[x >> 6] |= bit;
+            }
+        }
+        setPastWidth(right, bitboard.words, bitboard.width - 1);
+        if (y+1 == bitboard.height)
+        {
+            fill(down, down + bitboard.words, ~uint64_t{0});
+        }
+        else
+        {
+            setPastWidth(down, bitboard.words, bitboard.width);
+        }
+    }
+    return bitboard;
+}
+
+void MazeBitboard::toMaze(Maze& maze) const
+{
+    maze.addAllWalls();
+    for (int y = 0; y < height; y++)
+    {
+        const uint64_t* right = rightWalls(y);
+        const uint64_t* down = downWalls(y);
+        for (int x = 0; x < width; x++)
+        {
+            uint64_t bit = uint64_t{1} << (x & 63);
+            if (x+1 < width && !(right[x >> 6] & bit))
+            {
+                maze.removeWall(x,y,Direction::right);
+            }
+            if (y+1 < height && !(down[x >> 6] & bit))
+            {
+                maze.removeWall(x,y,Direction::down);
+            }
+        }
+    }
+}
+
+MazeBitboard::Header MazeBitboard::makeHeader(int width,int height)
+{
+    Header header{};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.headerSize = sizeof(Header);
+    header.width = width;
+    header.height = height;
+    header.rowWords = (static_cast<uint64_t>(width) + 63) / 64;
+    return header;
+}
+
+void MazeBitboard::save(const string& path) const
+{
+    ofstream out{path, ios::binary};
+    Header header = makeHeader(width, height);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(rows), 2 * words * height * sizeof(uint64_t));
+    if (!out)
+    {
+        throw runtime_error{"could not write maze bitboard " + path};
+    }
+}
+
+MazeBitboard MazeBitboard::map(const string& path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw runtime_error{"could not open maze bitboard " + path};
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header))
+    {
+        close(fd);
+        throw runtime_error{"not a maze bitboard: " + path};
+    }
+
+    size_t bytes = info.st_size;
+    void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        throw runtime_error{"could not map maze bitboard " + path};
+    }
+
+    const Header* header = static_cast<const Header*>(mapping);
+    size_t rowWords = (static_cast<size_t>(header->width) + 63) / 64;
+    if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0
+        || header->version != VERSION
+        || header->headerSize != sizeof(Header)
+        || header->width > INT_MAX
+        || header->height > INT_MAX
+        || header->rowWords != rowWords
+        || bytes < sizeof(Header) + 2 * rowWords * header->height * sizeof(uint64_t))
+    {
+        munmap(mapping, bytes);
+        throw runtime_error{"not a maze bitboard: " + path};
+    }
+
+    MazeBitboard bitboard;
+    bitboard.width = header->width;
+    bitboard.height = header->height;
+    bitboard.words = rowWords;
+    bitboard.mapping = mapping;
+    bitboard.mappingBytes = bytes;
+    bitboard.rows = reinterpret_cast<uint64_t*>(static_cast<char*>(mapping) + sizeof(Header));
+    return bitboard;
+}
+
+int MazeBitboard::getWidth() const noexcept
+{
+    return width;
+}
+
+int MazeBitboard::getHeight() const noexcept
+{
+    return height;
+}
+
+size_t MazeBitboard::rowWords() const noexcept
+{
+    return words;
+}
+
+bool MazeBitboard::isMapped() const noexcept
+{
+    return mapping != nullptr;
+}
+
+const uint64_t* MazeBitboard::rightWalls(int y) const noexcept
+{
+    return rows + 2 * words * y;
+}
+
+const uint64_t* MazeBitboard::downWalls(int y) const noexcept
+{
+    return rows + 2 * words * y + words;
+}
+
+uint64_t* MazeBitboard::rightWalls(int y) noexcept
+{
+    return rows + 2 * words * y;
+}
+
+uint64_t* MazeBitboard::downWalls(int y) noexcept
+{
+    return rows + 2 * words * y + words;
+}
+
+bool MazeBitboard::wallExists(int x,int y,Direction direction) const
+{
+    switch (direction)
+    {
+    case Direction::right:
+        return (rightWalls(y)[x >> 6] >> (x & 63)) & 1;
+    case Direction::down:
+        return (downWalls(y)[x >> 6] >> (x & 63)) & 1;
+    case Direction::left:
+        return x == 0 || ((rightWalls(y)[(x-1) >> 6] >> ((x-1) & 63)) & 1);
+    default:
+        return y == 0 || ((downWalls(y-1)[x >> 6] >> (x & 63)) & 1);
+    }
+}
+
+void MazeBitboard::addWall(int x,int y,Direction direction)
+{
+    setWall(x,y,direction,true);
+}
+
+void MazeBitboard::removeWall(int x,int y,Direction direction)
+{
+    setWall(x,y,direction,false);
+}
+
+// The outer walls can't be removed, so those requests are ignored.
+void MazeBitboard::setWall(int x,int y,Direction direction,bool present)
+{
+    uint64_t* word = nullptr;
+    int bit = 0;
+    switch (direction)
+    {
+    case Direction::right:
+        if (x+1 >= width)
+        {
+            return;
+        }
+        word = &rightWalls(y)[x >> 6];
+        bit = x & 63;
+        break;
+    case Direction::down:
+        if (y+1 >= height)
+        {
+            return;
+        }
+        word = &downWalls(y)[x >> 6];
+        bit = x & 63;
+        break;
+    case Direction::left:
+        if (x == 0)
+        {
+            return;
+        }
+        word = &rightWalls(y)[(x-1) >> 6];
+        bit = (x-1) & 63;
+        break;
+    case Direction::up:
+        if (y == 0)
+        {
+            return;
+        }
+        word = &downWalls(y-1)[x >> 6];
+        bit = x & 63;
+        break;
+    }
+    if (present)
+    {
+        *word |= uint64_t{1} << bit;
+    }
+    else
+    {
+        *word &= ~(uint64_t{1} << bit);
+    }
+}
+
+
+MazeBitboardWriter::MazeBitboardWriter(const string& path,int width,int height)
+    : path{path}, out{path, ios::binary}, width{width}, height{height}, rowsWritten{0},
+      row(2 * ((static_cast<size_t>(width) + 63) / 64))
+{
+    MazeBitboard::Header header = MazeBitboard::makeHeader(width, height);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!out)
+    {
+        throw runtime_error{"could not write maze bitboard " + path};
+    }
+}
+
+void MazeBitboardWriter::writeRow(const vector<bool>& rightWall,const vector<bool>& downWall)
+{
+    size_t words = row.size() / 2;
+    fill(row.begin(), row.end(), 0);
+    for (int x = 0; x < width; x++)
+    {
+        uint64_t bit = uint64_t{1} << (x & 63);
+        if (rightWall[x])
+        {
+            row[x >> 6] |= bit;
+        }
+        if (downWall[x])
+        {
+            row[words + (x >> 6)] |= bit;
+        }
+    }
+    // The outer walls are forced the same way fromMaze() forces them.
+    setPastWidth(row.data(), words, width - 1);
+    if (rowsWritten + 1 == height)
+    {
+        fill(row.begin() + words, row.end(), ~uint64_t{0});
+    }
+    else
+    {
+        setPastWidth(row.data() + words, words, width);
+    }
+    out.write(reinterpret_cast<const char*>(row.data()), row.size() * sizeof(uint64_t));
+    if (!out)
+    {
+        throw runtime_error{"could not write maze bitboard row"};
+    }
+    rowsWritten++;
+}
+
+void MazeBitboardWriter::finish()
+{
+    if (rowsWritten != height)
+    {
+        throw runtime_error{"maze bitboard " + path + " is missing rows"};
+    }
+    out.close();
+    if (!out)
+    {
+        throw runtime_error{"could not write maze bitboard " + path};
+    }
+}
@@ -0,0 +1,119 @@
+#ifndef MAZEBITBOARD_HPP
+#define MAZEBITBOARD_HPP
+
+#include "Maze.hpp"
+#include "Direction.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// A MazeBitboard holds a maze as two wall bits per cell: whether the wall
+// to the right of the cell is there and whether the wall below it is.
+// The walls above and to the left belong to the neighbouring cells, and
+// the outer walls on the right and bottom edges are always set.
+//
+// Each row is stored as rowWords() 64-bit words of right walls followed
+// by rowWords() words of down walls, bit x of a row being cell x.  On disk
+// a fixed 64-byte header comes first and the rows follow unchanged, so
+// map() can memory-map a saved file and use it with no parsing.
+class MazeBitboard
+{
+public:
+    static constexpr char MAGIC[8] = {'I','C','S','M','A','Z','E','1'};
+    static constexpr uint32_t VERSION = 1;
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t headerSize;
+        uint32_t width;
+        uint32_t height;
+        uint64_t rowWords;
+        uint64_t reserved[4];
+    };
+
+public:
+    MazeBitboard();
+
+    // A width x height bitboard with every wall in place.
+    MazeBitboard(int width,int height);
+
+    ~MazeBitboard();
+    MazeBitboard(MazeBitboard&& other) noexcept;
+    MazeBitboard& operator=(MazeBitboard&& other) noexcept;
+    MazeBitboard(const MazeBitboard&) = delete;
+    MazeBitboard& operator=(const MazeBitboard&) = delete;
+
+    static MazeBitboard fromMaze(const Maze& maze);
+    void toMaze(Maze& maze) const;
+
+    // map() memory-maps a file written by save() or MazeBitboardWriter.
+    // Changes made through addWall() and removeWall() stay in memory and
+    // never reach the file.  Throws runtime_error if the file can't be
+    // opened or isn't a maze bitboard, including when its width or height
+    // doesn't fit in an int.
+    static MazeBitboard map(const string& path);
+    void save(const string& path) const;
+
+    int getWidth() const noexcept;
+    int getHeight() const noexcept;
+    size_t rowWords() const noexcept;
+    bool isMapped() const noexcept;
+
+    bool wallExists(int x,int y,Direction direction) const;
+    void addWall(int x,int y,Direction direction);
+    void removeWall(int x,int y,Direction direction);
+
+    const uint64_t* rightWalls(int y) const noexcept;
+    const uint64_t* downWalls(int y) const noexcept;
+    uint64_t* rightWalls(int y) noexcept;
+    uint64_t* downWalls(int y) noexcept;
+
+    static Header makeHeader(int width,int height);
+
+private:
+    void setWall(int x,int y,Direction direction,bool present);
+    void release() noexcept;
+
+private:
+    int width;
+    int height;
+    size_t words;
+    uint64_t* rows;
+    vector<uint64_t> owned;
+    void* mapping;
+    size_t mappingBytes;
+};
+
+
+// MazeBitboardWriter writes a bitboard file one row at a time, so a maze
+// built row by row (myEllerMazeGenerator::generateRows) can be saved
+// without ever being held in memory.  finish() must be called once the
+// last row is written: it flushes the file and throws if any of it didn't
+// reach the disk.  The destructor closes an unfinished file too, but has
+// nowhere to report a failed write.
+class MazeBitboardWriter
+{
+public:
+    MazeBitboardWriter(const string& path,int width,int height);
+
+    void writeRow(const vector<bool>& rightWall,const vector<bool>& downWall);
+
+    // Throws runtime_error if fewer than height rows were written or the
+    // file couldn't be flushed and closed.
+    void finish();
+
+private:
+    string path;
+    ofstream out;
+    int width;
+    int height;
+    int rowsWritten;
+    vector<uint64_t> row;
+};
+
+#endif
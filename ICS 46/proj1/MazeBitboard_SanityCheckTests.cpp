@@ -0,0 +1,116 @@
+// MazeBitboard_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks that bitboard files load back the maze that was saved, whether
+// they were saved whole or written a row at a time, and that map() turns
+// away files that aren't maze bitboards.
+
+#include <gtest/gtest.h>
+#include "MazeBitboard.hpp"
+#include "MazeSanityChecks.hpp"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace MazeSanityChecks;
+
+
+TEST(MazeBitboard_SanityCheckTests, filesRoundTrip)
+{
+    std::unique_ptr<Maze> maze = perfectMaze(10);
+    std::string directory = temporaryDirectory("maze-bitboard");
+    std::string path = directory + "/maze.bitboard";
+    MazeBitboard::fromMaze(*maze).save(path);
+
+    MazeBitboard mapped = MazeBitboard::map(path);
+    EXPECT_TRUE(mapped.isMapped());
+    std::unique_ptr<Maze> loaded = MazeFactory{}.createMaze(WIDTH, HEIGHT);
+    mapped.toMaze(*loaded);
+    for (int y = 0; y < HEIGHT; y++)
+    {
+        for (int x = 0; x < WIDTH; x++)
+        {
+            for (Direction direction : {Direction::up, Direction::down, Direction::left, Direction::right})
+            {
+                EXPECT_EQ(maze->wallExists(x, y, direction), mapped.wallExists(x, y, direction));
+            }
+        }
+    }
+    EXPECT_TRUE(sameWalls(*maze, *loaded));
+    std::remove(path.c_str());
+    rmdir(directory.c_str());
+}
+
+
+// A row that leaves the outer walls open still maps back with them shut.
+TEST(MazeBitboard_SanityCheckTests, writerKeepsTheOuterWalls)
+{
+    std::string directory = temporaryDirectory("maze-bitboard-writer");
+    std::string path = directory + "/maze.bitboard";
+    {
+        MazeBitboardWriter writer{path, 70, 3};
+        for (int y = 0; y < 3; y++)
+        {
+            writer.writeRow(std::vector<bool>(70, false), std::vector<bool>(70, false));
+        }
+        writer.finish();
+    }
+
+    MazeBitboard mapped = MazeBitboard::map(path);
+    ASSERT_EQ(70, mapped.getWidth());
+    ASSERT_EQ(3, mapped.getHeight());
+    for (int y = 0; y < 3; y++)
+    {
+        EXPECT_TRUE(mapped.wallExists(69, y, Direction::right));
+        EXPECT_FALSE(mapped.wallExists(68, y, Direction::right));
+    }
+    for (int x = 0; x < 70; x++)
+    {
+        EXPECT_TRUE(mapped.wallExists(x, 2, Direction::down));
+        EXPECT_FALSE(mapped.wallExists(x, 1, Direction::down));
+    }
+    std::remove(path.c_str());
+    rmdir(directory.c_str());
+}
+
+
+TEST(MazeBitboard_SanityCheckTests, finishReportsMissingRows)
+{
+    std::string directory = temporaryDirectory("maze-bitboard-short");
+    std::string path = directory + "/maze.bitboard";
+    MazeBitboardWriter writer{path, 4, 4};
+    writer.writeRow(std::vector<bool>(4, true), std::vector<bool>(4, true));
+    EXPECT_THROW(writer.finish(), std::runtime_error);
+    std::remove(path.c_str());
+    rmdir(directory.c_str());
+}
+
+
+TEST(MazeBitboard_SanityCheckTests, mapRejectsBadFiles)
+{
+    std::string directory = temporaryDirectory("maze-bitboard-bad");
+    std::string path = directory + "/maze.bitboard";
+    EXPECT_THROW(MazeBitboard::map(path), std::runtime_error);
+
+    {
+        std::ofstream out{path, std::ios::binary};
+        out << "not a maze at all, just some text that is long enough to be a header";
+    }
+    EXPECT_THROW(MazeBitboard::map(path), std::runtime_error);
+
+    MazeBitboard::Header header = MazeBitboard::makeHeader(4, 4);
+    header.width = 0x80000000u;
+    {
+        std::ofstream out{path, std::ios::binary};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out << std::string(4096, '\0');
+    }
+    EXPECT_THROW(MazeBitboard::map(path), std::runtime_error);
+    std::remove(path.c_str());
+    rmdir(directory.c_str());
+}
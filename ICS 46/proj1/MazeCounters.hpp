@@ -0,0 +1,68 @@
+#ifndef MAZECOUNTERS_HPP
+#define MAZECOUNTERS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+// What a run of myMazeGenerator or myMazeSolver did, counted rather than
+// timed, so a change in the algorithm shows up even when timings are too
+// noisy to tell.  With a fixed seed every count is exactly repeatable.
+struct MazeCounters
+{
+    // Deepest the path back to the start got: the recursion or stack
+    // depth for a generator, the length of the route so far for a solver.
+    std::uint64_t maxStackDepth = 0;
+
+    // Steps back along that path: stack pops or returns for a generator,
+    // MazeSolution::backUp() calls, or moves taken back in replay mode,
+    // for a solver.
+    std::uint64_t backtracks = 0;
+
+    // Maze::wallExists() calls.
+    std::uint64_t wallChecks = 0;
+
+    // Random choices made, one per direction picked or position chosen.
+    std::uint64_t randomDraws = 0;
+
+    // Cells marked visited, each counted once.
+    std::uint64_t cellsVisited = 0;
+
+    void reachedDepth(std::size_t depth);
+
+    // Adds other's counts to these, keeping the larger maximum depth.
+    MazeCounters& operator+=(const MazeCounters& other);
+};
+
+std::ostream& operator<<(std::ostream& out, const MazeCounters& counters);
+
+
+inline void MazeCounters::reachedDepth(std::size_t depth)
+{
+    maxStackDepth = std::max<std::uint64_t>(maxStackDepth, depth);
+}
+
+
+inline MazeCounters& MazeCounters::operator+=(const MazeCounters& other)
+{
+    maxStackDepth = std::max(maxStackDepth, other.maxStackDepth);
+    backtracks += other.backtracks;
+    wallChecks += other.wallChecks;
+    randomDraws += other.randomDraws;
+    cellsVisited += other.cellsVisited;
+    return *this;
+}
+
+
+inline std::ostream& operator<<(std::ostream& out, const MazeCounters& counters)
+{
+    return out << "depth " << counters.maxStackDepth
+               << ", backtracks " << counters.backtracks
+               << ", wall checks " << counters.wallChecks
+               << ", random draws " << counters.randomDraws
+               << ", cells visited " << counters.cellsVisited;
+}
+
+
+#endif
@@ -0,0 +1,71 @@
+// MazeCounters_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks the counts that have to come out exact whatever the random
+// choices: every cell visited once, and a depth no deeper than the maze.
+
+#include <gtest/gtest.h>
+#include "MazeCounters.hpp"
+#include "myMazeGenerator.hpp"
+#include "myMazeSolver.hpp"
+#include "MazeSolutionFactory.hpp"
+#include "MazeSanityChecks.hpp"
+
+using namespace MazeSanityChecks;
+
+
+TEST(MazeCounters_SanityCheckTests, addingKeepsTheDeepest)
+{
+    MazeCounters a;
+    a.reachedDepth(7);
+    a.reachedDepth(3);
+    a.backtracks = 2;
+    a.cellsVisited = 5;
+    MazeCounters b;
+    b.reachedDepth(4);
+    b.backtracks = 1;
+    b.wallChecks = 9;
+    a += b;
+    EXPECT_EQ(7u, a.maxStackDepth);
+    EXPECT_EQ(3u, a.backtracks);
+    EXPECT_EQ(9u, a.wallChecks);
+    EXPECT_EQ(5u, a.cellsVisited);
+}
+
+
+TEST(MazeCounters_SanityCheckTests, generatorVisitsEveryCellOnce)
+{
+    const std::uint64_t cells = WIDTH * HEIGHT;
+    for (myMazeGenerator::Mode mode : {myMazeGenerator::Mode::recursive, myMazeGenerator::Mode::iterative,
+                                       myMazeGenerator::Mode::parallel})
+    {
+        myMazeGenerator generator{mode};
+        generator.setSeed(20);
+        generated(generator);
+        const MazeCounters& counters = generator.getCounters();
+        EXPECT_EQ(cells, counters.cellsVisited);
+        EXPECT_GE(counters.maxStackDepth, 1u);
+        EXPECT_LE(counters.maxStackDepth, cells);
+        EXPECT_GT(counters.randomDraws, 0u);
+    }
+}
+
+
+TEST(MazeCounters_SanityCheckTests, solverCountsMatchItsRoute)
+{
+    std::unique_ptr<Maze> maze = perfectMaze(21);
+    for (myMazeSolver::Mode mode : {myMazeSolver::Mode::stepwise, myMazeSolver::Mode::replay})
+    {
+        myMazeSolver solver{mode};
+        solver.setSeed(22);
+        std::unique_ptr<MazeSolution> solution = MazeSolutionFactory{}.createMazeSolution(WIDTH, HEIGHT);
+        solver.solveMaze(*maze, *solution);
+        ASSERT_TRUE(solvedCorrectly(*maze, *solution));
+        const MazeCounters& counters = solver.getCounters();
+        EXPECT_GE(counters.maxStackDepth, solution->getMovements().size());
+        EXPECT_GE(counters.cellsVisited, solution->getMovements().size() + 1);
+        EXPECT_LE(counters.cellsVisited, static_cast<std::uint64_t>(WIDTH * HEIGHT));
+    }
+}
@@ -0,0 +1,255 @@
+#include "MazeHierarchy.hpp"
+#include "MazeSearch.hpp"
+#include <algorithm>
+#include <climits>
+#include <functional>
+using namespace std;
+
+void MazeHierarchy::build(const Maze& maze,int clusterSize)
+{
+    this->maze = &maze;
+    width = maze.getWidth();
+    height = maze.getHeight();
+    this->clusterSize = clusterSize > 0 ? clusterSize : DEFAULT_CLUSTER_SIZE;
+    clustersAcross = (width + this->clusterSize - 1) / this->clusterSize;
+    clustersDown = (height + this->clusterSize - 1) / this->clusterSize;
+    int clusters = clustersAcross * clustersDown;
+
+    entranceCell.clear();
+    entranceOfCell.assign(static_cast<size_t>(width) * height, -1);
+    clusterFirst.assign(clusters + 1, 0);
+    for (int cluster = 0; cluster < clusters; cluster++)
+    {
+        clusterFirst[cluster] = static_cast<int32_t>(entranceCell.size());
+        int left = (cluster % clustersAcross) * this->clusterSize;
+        int top = (cluster / clustersAcross) * this->clusterSize;
+        int right = min(left + this->clusterSize, width);
+        int bottom = min(top + this->clusterSize, height);
+        for (int y = top; y < bottom; y++)
+        {
+            for (int x = left; x < right; x++)
+            {
+                for (Direction direction : MazeSearch::directions)
+                {
+                    int xc = x;
+                    int yc = y;
+                    MazeSearch::step(direction,xc,yc);
+                    if (MazeSearch::canMove(maze,x,y,direction) && clusterOf(xc,yc) != cluster)
+                    {
+                        size_t cell = MazeSearch::cellIndex(x,y,width);
+                        entranceOfCell[cell] = static_cast<int32_t>(entranceCell.size());
+                        entranceCell.push_back(static_cast<int32_t>(cell));
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    clusterFirst[clusters] = static_cast<int32_t>(entranceCell.size());
+
+    // Each entrance gets an edge to every entrance of its cluster it can
+    // reach without leaving the cluster, then one through each door.
+    edges.clear();
+    edgeFirst.assign(entranceCell.size() + 1, 0);
+    for (int cluster = 0; cluster < clusters; cluster++)
+    {
+        for (int32_t entrance = clusterFirst[cluster]; entrance < clusterFirst[cluster+1]; entrance++)
+        {
+            edgeFirst[entrance] = static_cast<int32_t>(edges.size());
+            int x = entranceCell[entrance] % width;
+            int y = entranceCell[entrance] / width;
+            searchCluster({x,y});
+            for (int32_t other = clusterFirst[cluster]; other < clusterFirst[cluster+1]; other++)
+            {
+                int d = clusterDistance({entranceCell[other] % width, entranceCell[other] / width});
+                if (other != entrance && d >= 0)
+                {
+                    edges.push_back({other, d});
+                }
+            }
+
+            for (Direction direction : MazeSearch::directions)
+            {
+                int xc = x;
+                int yc = y;
+                MazeSearch::step(direction,xc,yc);
+                if (MazeSearch::canMove(maze,x,y,direction) && clusterOf(xc,yc) != cluster)
+                {
+                    edges.push_back({entranceOfCell[MazeSearch::cellIndex(xc,yc,width)], 1});
+                }
+            }
+        }
+    }
+    edgeFirst[entranceCell.size()] = static_cast<int32_t>(edges.size());
+}
+
+int MazeHierarchy::getClusterCount() const
+{
+    return clustersAcross * clustersDown;
+}
+
+int MazeHierarchy::getEntranceCount() const
+{
+    return static_cast<int>(entranceCell.size());
+}
+
+int MazeHierarchy::clusterOf(int x,int y) const
+{
+    return (y / clusterSize) * clustersAcross + x / clusterSize;
+}
+
+myBFSMazeSolver::Window MazeHierarchy::clusterWindow(pair<int,int> cell) const
+{
+    int left = (cell.first / clusterSize) * clusterSize;
+    int top = (cell.second / clusterSize) * clusterSize;
+    return {left, top, min(clusterSize, width - left), min(clusterSize, height - top)};
+}
+
+// Distances from a cell to the rest of its cluster, without leaving it.
+void MazeHierarchy::searchCluster(pair<int,int> from)
+{
+    cluster = clusterWindow(from);
+    bfs.distanceField(*maze,from,cluster,distance);
+}
+
+// Distance found by the last searchCluster() to a cell of the same
+// cluster, or -1.
+int MazeHierarchy::clusterDistance(pair<int,int> cell) const
+{
+    uint32_t d = distance[MazeSearch::cellIndex(cell.first - cluster.left,cell.second - cluster.top,cluster.width)];
+    return d == myBFSMazeSolver::UNREACHABLE ? -1 : static_cast<int>(d);
+}
+
+void MazeHierarchy::appendSegment(pair<int,int> from,pair<int,int> to,vector<Direction>& path)
+{
+    bfs.findPath(*maze,from,to,clusterWindow(from),segment);
+    path.insert(path.end(), segment.begin(), segment.end());
+}
+
+bool MazeHierarchy::findPath(pair<int,int> start,pair<int,int> end,vector<Direction>& path)
+{
+    path.clear();
+    int startCluster = clusterOf(start.first,start.second);
+    int endCluster = clusterOf(end.first,end.second);
+    size_t entrances = entranceCell.size();
+    cost.assign(entrances, INT_MAX);
+    parent.assign(entrances, -1);
+    open.clear();
+
+    // best is the shortest route found so far; it ends at the entrance
+    // bestEntrance, or stays inside one cluster if that is -1.
+    int best = INT_MAX;
+    int32_t bestEntrance = -1;
+
+    searchCluster(end);
+    int32_t endFirst = clusterFirst[endCluster];
+    toEnd.assign(clusterFirst[endCluster+1] - endFirst, -1);
+    for (int32_t entrance = endFirst; entrance < clusterFirst[endCluster+1]; entrance++)
+    {
+        toEnd[entrance - endFirst] = clusterDistance({entranceCell[entrance] % width, entranceCell[entrance] / width});
+    }
+    if (startCluster == endCluster && clusterDistance(start) >= 0)
+    {
+        best = clusterDistance(start);
+    }
+
+    searchCluster(start);
+    for (int32_t entrance = clusterFirst[startCluster]; entrance < clusterFirst[startCluster+1]; entrance++)
+    {
+        int d = clusterDistance({entranceCell[entrance] % width, entranceCell[entrance] / width});
+        if (d >= 0)
+        {
+            cost[entrance] = d;
+            open.push_back({d, entrance});
+        }
+    }
+    make_heap(open.begin(), open.end(), greater<pair<int32_t,int32_t>>{});
+
+    while (open.size() > 0)
+    {
+        pop_heap(open.begin(), open.end(), greater<pair<int32_t,int32_t>>{});
+        int32_t reached = open.back().first;
+        int32_t entrance = open.back().second;
+        open.pop_back();
+        if (reached != cost[entrance])
+        {
+            continue;
+        }
+        if (reached >= best)
+        {
+            break;
+        }
+        if (entrance >= endFirst && entrance < clusterFirst[endCluster+1]
+            && toEnd[entrance - endFirst] >= 0 && reached + toEnd[entrance - endFirst] < best)
+        {
+            best = reached + toEnd[entrance - endFirst];
+            bestEntrance = entrance;
+        }
+        for (int32_t i = edgeFirst[entrance]; i < edgeFirst[entrance+1]; i++)
+        {
+            const Edge& edge = edges[i];
+            if (reached + edge.cost < cost[edge.to])
+            {
+                cost[edge.to] = reached + edge.cost;
+                parent[edge.to] = entrance;
+                open.push_back({cost[edge.to], edge.to});
+                push_heap(open.begin(), open.end(), greater<pair<int32_t,int32_t>>{});
+            }
+        }
+    }
+
+    if (best == INT_MAX)
+    {
+        return false;
+    }
+    if (bestEntrance < 0)
+    {
+        appendSegment(start,end,path);
+        return true;
+    }
+
+    // Refine the abstract route: a search inside the cluster between two
+    // entrances of the same cluster, a single move through a door.
+    vector<int32_t> route;
+    for (int32_t entrance = bestEntrance; entrance >= 0; entrance = parent[entrance])
+    {
+        route.push_back(entrance);
+    }
+    reverse(route.begin(), route.end());
+
+    pair<int,int> at = start;
+    for (int32_t entrance : route)
+    {
+        pair<int,int> next{entranceCell[entrance] % width, entranceCell[entrance] / width};
+        if (clusterOf(at.first,at.second) == clusterOf(next.first,next.second))
+        {
+            appendSegment(at,next,path);
+        }
+        else
+        {
+            for (Direction direction : MazeSearch::directions)
+            {
+                int xc = at.first;
+                int yc = at.second;
+                MazeSearch::step(direction,xc,yc);
+                if (xc == next.first && yc == next.second)
+                {
+                    path.push_back(direction);
+                    break;
+                }
+            }
+        }
+        at = next;
+    }
+    appendSegment(at,end,path);
+    return true;
+}
+
+void MazeHierarchy::writePath(MazeSolution& mazeSolution)
+{
+    vector<Direction> path;
+    if (findPath(mazeSolution.getStartingCell(),mazeSolution.getEndingCell(),path))
+    {
+        MazeSearch::writePath(path,mazeSolution);
+    }
+}
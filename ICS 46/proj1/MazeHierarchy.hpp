@@ -0,0 +1,89 @@
+#ifndef MAZEHIERARCHY_HPP
+#define MAZEHIERARCHY_HPP
+
+#include "Maze.hpp"
+#include "MazeSolution.hpp"
+#include "Direction.hpp"
+#include "myBFSMazeSolver.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// Hierarchical pathfinding (HPA*) for answering many route queries on one
+// maze.  build() cuts the grid into square clusters.  Every cell with an
+// open wall into another cluster is an entrance, and the abstract graph
+// joins entrances of the same cluster by their distance inside it and
+// entrances on either side of an open wall by 1.  Since every door is an
+// entrance, the routes found are exact shortest routes.
+//
+// A query searches the start's and the end's clusters to tie them to
+// their entrances, runs Dijkstra over the abstract graph, and then fills
+// in each step inside a cluster with a breadth-first search confined to
+// that cluster, myBFSMazeSolver's windowed one.  Apart from those few cluster searches its cost depends
+// on the number of entrances, not the number of cells.
+class MazeHierarchy
+{
+public:
+    static constexpr int DEFAULT_CLUSTER_SIZE = 32;
+
+    // build() keeps a pointer to maze, which has to stay alive and
+    // unchanged while the hierarchy is queried.
+    void build(const Maze& maze,int clusterSize = DEFAULT_CLUSTER_SIZE);
+
+    int getClusterCount() const;
+    int getEntranceCount() const;
+
+    // findPath() leaves a shortest route from start to end in path and
+    // returns false if end can't be reached.
+    bool findPath(pair<int,int> start,pair<int,int> end,vector<Direction>& path);
+
+    // writePath() puts the route between the solution's starting and
+    // ending cells into it.
+    void writePath(MazeSolution& mazeSolution);
+
+private:
+    struct Edge
+    {
+        int32_t to;
+        int32_t cost;
+    };
+
+    int clusterOf(int x,int y) const;
+    myBFSMazeSolver::Window clusterWindow(pair<int,int> cell) const;
+    void searchCluster(pair<int,int> from);
+    int clusterDistance(pair<int,int> cell) const;
+    void appendSegment(pair<int,int> from,pair<int,int> to,vector<Direction>& path);
+
+private:
+    const Maze* maze = nullptr;
+    int width = 0;
+    int height = 0;
+    int clusterSize = DEFAULT_CLUSTER_SIZE;
+    int clustersAcross = 0;
+    int clustersDown = 0;
+
+    // Entrances are numbered cluster by cluster: those of cluster c are
+    // [clusterFirst[c], clusterFirst[c+1]).  The edges of entrance n are
+    // edges[edgeFirst[n], edgeFirst[n+1]).
+    vector<int32_t> entranceCell;
+    vector<int32_t> entranceOfCell;
+    vector<int32_t> clusterFirst;
+    vector<int32_t> edgeFirst;
+    vector<Edge> edges;
+
+    // The last searchCluster(), over the cluster's own cells numbered
+    // row-major from its top-left corner.
+    myBFSMazeSolver bfs;
+    myBFSMazeSolver::Window cluster = {0, 0, 0, 0};
+    vector<uint32_t> distance;
+
+    // Query state, one entry per entrance.
+    vector<int32_t> cost;
+    vector<int32_t> parent;
+    vector<int32_t> toEnd;
+    vector<pair<int32_t,int32_t>> open;
+    vector<Direction> segment;
+};
+
+#endif
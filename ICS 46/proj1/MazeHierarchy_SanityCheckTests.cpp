@@ -0,0 +1,78 @@
+// MazeHierarchy_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks that HPA* routes are as short as breadth-first search's for any
+// cluster size, on mazes with and without loops.
+
+#include <gtest/gtest.h>
+#include "MazeHierarchy.hpp"
+#include "myBFSMazeSolver.hpp"
+#include "MazeSolutionFactory.hpp"
+#include "MazeSanityChecks.hpp"
+#include <vector>
+
+using namespace MazeSanityChecks;
+
+
+TEST(MazeHierarchy_SanityCheckTests, findsTheShortestRouteThroughLoops)
+{
+    std::unique_ptr<Maze> maze = bandedMaze();
+    std::vector<Direction> path;
+    for (int clusterSize : {1, 5, 8, 64})
+    {
+        MazeHierarchy hierarchy;
+        hierarchy.build(*maze, clusterSize);
+        EXPECT_TRUE(hierarchy.findPath({0, 0}, {WIDTH-1, HEIGHT-1}, path)) << "clusters of " << clusterSize;
+        EXPECT_TRUE(isRoute(*maze, {0, 0}, {WIDTH-1, HEIGHT-1}, path));
+        EXPECT_EQ(static_cast<size_t>(WIDTH + HEIGHT - 2), path.size());
+    }
+}
+
+
+TEST(MazeHierarchy_SanityCheckTests, matchesBreadthFirstLengths)
+{
+    std::unique_ptr<Maze> maze = perfectMaze(23);
+    for (int x = 1; x+1 < WIDTH; x += 3)
+    {
+        maze->removeWall(x, HEIGHT/2, Direction::down);
+    }
+    MazeHierarchy hierarchy;
+    hierarchy.build(*maze, 8);
+    EXPECT_EQ(5 * 3, hierarchy.getClusterCount());
+
+    myBFSMazeSolver bfs;
+    std::vector<Direction> expected;
+    std::vector<Direction> path;
+    for (int i = 0; i < 60; i++)
+    {
+        std::pair<int,int> start{(i * 7) % WIDTH, (i * 3) % HEIGHT};
+        std::pair<int,int> end{(i * 13 + 5) % WIDTH, (i * 11 + 2) % HEIGHT};
+        ASSERT_TRUE(bfs.findPath(*maze, start, end, expected));
+        ASSERT_TRUE(hierarchy.findPath(start, end, path));
+        EXPECT_TRUE(isRoute(*maze, start, end, path));
+        EXPECT_EQ(expected.size(), path.size());
+    }
+
+    std::unique_ptr<MazeSolution> solution = MazeSolutionFactory{}.createMazeSolution(WIDTH, HEIGHT);
+    hierarchy.writePath(*solution);
+    EXPECT_TRUE(solvedCorrectly(*maze, *solution));
+}
+
+
+TEST(MazeHierarchy_SanityCheckTests, reportsAnUnreachableEnd)
+{
+    std::unique_ptr<Maze> maze = MazeFactory{}.createMaze(6, 6);
+    maze->removeAllWalls();
+    for (int x = 0; x < 6; x++)
+    {
+        maze->addWall(x, 2, Direction::down);
+    }
+    MazeHierarchy hierarchy;
+    hierarchy.build(*maze, 2);
+    std::vector<Direction> path;
+    EXPECT_FALSE(hierarchy.findPath({0, 0}, {5, 5}, path));
+    EXPECT_TRUE(hierarchy.findPath({0, 0}, {5, 2}, path));
+    EXPECT_EQ(7u, path.size());
+}
@@ -0,0 +1,126 @@
+#include "MazeLibraryGenerator.hpp"
+#include "MazeBitboard.hpp"
+#include "myEllerMazeGenerator.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <thread>
+using namespace std;
+
+MazeLibraryGenerator::MazeLibraryGenerator(unsigned int threadCount)
+{
+    setThreadCount(threadCount);
+}
+
+unsigned int MazeLibraryGenerator::getThreadCount() const
+{
+    return threadCount;
+}
+
+void MazeLibraryGenerator::setThreadCount(unsigned int threadCount)
+{
+    if (threadCount == 0)
+    {
+        threadCount = max(1u, thread::hardware_concurrency());
+    }
+    this->threadCount = threadCount;
+}
+
+string MazeLibraryGenerator::pathFor(const string& directory,size_t index)
+{
+    string number = to_string(index);
+    if (number.size() < 6)
+    {
+        number.insert(0, 6 - number.size(), '0');
+    }
+    return directory + "/maze-" + number + ".bitboard";
+}
+
+vector<string> MazeLibraryGenerator::generate(size_t count,int width,int height,uint64_t masterSeed,const string& directory)
+{
+    return generate(vector<pair<int,int>>(count, {width, height}), masterSeed, directory);
+}
+
+// The streams are jumped apart up front on the calling thread; a jump
+// costs about as much as 256 draws, far less than any maze worth storing.
+// Workers then take mazes off a shared counter, so a few big mazes in the
+// list do not leave the other threads idle.
+vector<string> MazeLibraryGenerator::generate(const vector<pair<int,int>>& sizes,uint64_t masterSeed,const string& directory)
+{
+    vector<string> paths(sizes.size());
+    vector<MazeRandom> streams;
+    streams.reserve(sizes.size());
+    MazeRandom stream{masterSeed};
+    for (size_t i = 0; i < sizes.size(); i++)
+    {
+        paths[i] = pathFor(directory, i);
+        stream.jump();
+        streams.push_back(stream);
+    }
+
+    auto start = chrono::steady_clock::now();
+    atomic<size_t> next{0};
+    atomic<bool> failed{false};
+    exception_ptr error;
+    mutex errorLock;
+    auto run = [&]()
+    {
+        myEllerMazeGenerator generator;
+        for (size_t i = next++; i < sizes.size() && !failed; i = next++)
+        {
+            try
+            {
+                generator.setRandom(streams[i]);
+                MazeBitboardWriter writer{paths[i], sizes[i].first, sizes[i].second};
+                generator.generateRows(sizes[i].first, sizes[i].second, writer);
+                writer.finish();
+            }
+            catch (...)
+            {
+                lock_guard<mutex> guard{errorLock};
+                if (!error)
+                {
+                    error = current_exception();
+                }
+                failed = true;
+            }
+        }
+    };
+
+    unsigned int threads = max<size_t>(1, min<size_t>(threadCount, sizes.size()));
+    vector<thread> workers;
+    for (unsigned int i = 1; i < threads; i++)
+    {
+        workers.emplace_back(run);
+    }
+    run();
+    for (thread& worker : workers)
+    {
+        worker.join();
+    }
+    if (error)
+    {
+        rethrow_exception(error);
+    }
+
+    statistics = MazeLibraryStatistics{};
+    statistics.mazes = sizes.size();
+    for (const pair<int,int>& size : sizes)
+    {
+        statistics.cells += static_cast<size_t>(size.first) * size.second;
+    }
+    statistics.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (statistics.seconds > 0.0)
+    {
+        statistics.mazesPerSecond = statistics.mazes / statistics.seconds;
+        statistics.cellsPerSecond = statistics.cells / statistics.seconds;
+    }
+    return paths;
+}
+
+MazeLibraryStatistics MazeLibraryGenerator::getStatistics() const
+{
+    return statistics;
+}
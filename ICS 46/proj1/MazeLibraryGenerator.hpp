@@ -0,0 +1,59 @@
+#ifndef MAZELIBRARYGENERATOR_HPP
+#define MAZELIBRARYGENERATOR_HPP
+
+#include "MazeRandom.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+using namespace std;
+
+struct MazeLibraryStatistics
+{
+    size_t mazes = 0;
+    size_t cells = 0;
+    double seconds = 0.0;
+    double mazesPerSecond = 0.0;
+    double cellsPerSecond = 0.0;
+};
+
+
+// A MazeLibraryGenerator builds a library of mazes offline, spread over
+// worker threads.  Each maze is made by Eller's generator, which streams
+// its rows straight into the maze's own bitboard file, so a worker holds
+// only one row at a time and a file is complete as soon as its maze is.
+//
+// Maze i is generated from its own stream: the master seed's generator
+// jumped ahead i+1 times.  Which worker picks a maze up never changes its
+// stream, so the same master seed writes byte-identical files whatever
+// the thread count.
+class MazeLibraryGenerator
+{
+public:
+    // A thread count of 0 means one per hardware core.
+    explicit MazeLibraryGenerator(unsigned int threadCount = 0);
+
+    unsigned int getThreadCount() const;
+    void setThreadCount(unsigned int threadCount);
+
+    // generate() writes maze i, of size sizes[i], to pathFor(directory,i)
+    // and returns the paths in order.  The directory must already exist.
+    // If a file cannot be written in full, including its final flush, the
+    // other workers stop taking mazes and the error is rethrown here.
+    vector<string> generate(const vector<pair<int,int>>& sizes,uint64_t masterSeed,const string& directory);
+
+    // Writes count mazes that are all width by height.
+    vector<string> generate(size_t count,int width,int height,uint64_t masterSeed,const string& directory);
+
+    static string pathFor(const string& directory,size_t index);
+
+    // Figures for the last generate().
+    MazeLibraryStatistics getStatistics() const;
+
+private:
+    unsigned int threadCount;
+    MazeLibraryStatistics statistics;
+};
+
+#endif
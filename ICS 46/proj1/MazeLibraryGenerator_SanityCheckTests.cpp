@@ -0,0 +1,74 @@
+// MazeLibraryGenerator_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks that a library comes out byte for byte the same whatever the
+// thread count, that every maze in it is perfect, and that a file that
+// can't be written is reported.  Run these under ThreadSanitizer too.
+
+#include <gtest/gtest.h>
+#include "MazeLibraryGenerator.hpp"
+#include "MazeBitboard.hpp"
+#include "MazeSanityChecks.hpp"
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <unistd.h>
+
+using namespace MazeSanityChecks;
+
+
+TEST(MazeLibraryGenerator_SanityCheckTests, isTheSameForAnyThreadCount)
+{
+    std::vector<std::pair<int,int>> sizes;
+    for (int i = 0; i < 10; i++)
+    {
+        sizes.push_back({3 + 5 * i, 2 + 3 * i});
+    }
+
+    std::string one = temporaryDirectory("maze-library-1");
+    std::string four = temporaryDirectory("maze-library-4");
+    MazeLibraryGenerator generator{1};
+    std::vector<std::string> onePaths = generator.generate(sizes, 12, one);
+    EXPECT_EQ(sizes.size(), generator.getStatistics().mazes);
+    generator.setThreadCount(4);
+    std::vector<std::string> fourPaths = generator.generate(sizes, 12, four);
+    ASSERT_EQ(sizes.size(), onePaths.size());
+    ASSERT_EQ(sizes.size(), fourPaths.size());
+
+    for (size_t i = 0; i < sizes.size(); i++)
+    {
+        EXPECT_EQ(MazeLibraryGenerator::pathFor(one, i), onePaths[i]);
+        EXPECT_EQ(contentsOf(onePaths[i]), contentsOf(fourPaths[i])) << "maze " << i;
+        MazeBitboard bitboard = MazeBitboard::map(onePaths[i]);
+        std::unique_ptr<Maze> maze = MazeFactory{}.createMaze(sizes[i].first, sizes[i].second);
+        bitboard.toMaze(*maze);
+        EXPECT_TRUE(isPerfect(*maze)) << "maze " << i;
+        std::remove(onePaths[i].c_str());
+        std::remove(fourPaths[i].c_str());
+    }
+    rmdir(one.c_str());
+    rmdir(four.c_str());
+}
+
+
+TEST(MazeLibraryGenerator_SanityCheckTests, differentSeedsMakeDifferentLibraries)
+{
+    std::string directory = temporaryDirectory("maze-library-seeds");
+    MazeLibraryGenerator generator{2};
+    std::string first = contentsOf(generator.generate(1, 20, 20, 14, directory)[0]);
+    std::string second = contentsOf(generator.generate(1, 20, 20, 15, directory)[0]);
+    EXPECT_NE(first, second);
+    std::remove(MazeLibraryGenerator::pathFor(directory, 0).c_str());
+    rmdir(directory.c_str());
+}
+
+
+TEST(MazeLibraryGenerator_SanityCheckTests, reportsWriteErrors)
+{
+    EXPECT_THROW(MazeLibraryGenerator{2}.generate(4, 5, 5, 13, "/nonexistent-directory"),
+                 std::runtime_error);
+}
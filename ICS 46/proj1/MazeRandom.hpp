@@ -0,0 +1,186 @@
+#ifndef MAZERANDOM_HPP
+#define MAZERANDOM_HPP
+
+#include <cstdint>
+#include <limits>
+#include <random>
+
+// MazeRandom is the xoshiro256** generator: 32 bytes of state, a handful
+// of shifts and rotates per 64-bit draw, and fully reproducible from a
+// 64-bit seed.  It meets the standard UniformRandomBitGenerator
+// requirements, so it also works with <random> distributions, but below()
+// and coin() are what the maze code uses: neither divides, and neither
+// needs a distribution object built per call.
+class MazeRandom
+{
+public:
+    using result_type = std::uint64_t;
+
+    // Seeds from std::random_device, so every object differs.
+    MazeRandom();
+
+    explicit MazeRandom(std::uint64_t seed);
+
+    // seed() restarts the sequence; the same seed gives the same draws.
+    void seed(std::uint64_t seed);
+
+    static constexpr result_type min()
+    {
+        return 0;
+    }
+
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()();
+
+    // below() returns a uniformly chosen integer in [0, bound).  It masks
+    // each half of a draw down to the bits bound needs and retries when
+    // the result is too big, which takes fewer than two tries on average.
+    std::uint32_t below(std::uint32_t bound);
+
+    // coin() is a fair coin flip using one bit of a draw.
+    bool coin();
+
+    // jump() moves the state ahead by 2^128 draws.  Copies of one
+    // generator jumped different numbers of times give sequences that
+    // cannot overlap in any realistic run, so they can be handed to
+    // separate threads.
+    void jump();
+
+private:
+    static std::uint64_t rotate(std::uint64_t x, int k);
+
+private:
+    std::uint64_t s[4];
+    std::uint64_t coinBits;
+    int coinsLeft;
+};
+
+
+inline MazeRandom::MazeRandom()
+{
+    std::random_device device;
+    seed((static_cast<std::uint64_t>(device()) << 32) ^ device());
+}
+
+
+inline MazeRandom::MazeRandom(std::uint64_t seed)
+{
+    this->seed(seed);
+}
+
+
+// The state is filled with splitmix64 so nearby seeds still give
+// unrelated sequences and the state is never all zero.
+inline void MazeRandom::seed(std::uint64_t seed)
+{
+    for (std::uint64_t& word : s)
+    {
+        seed += 0x9e3779b97f4a7c15;
+        std::uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        word = z ^ (z >> 31);
+    }
+    coinBits = 0;
+    coinsLeft = 0;
+}
+
+
+inline std::uint64_t MazeRandom::rotate(std::uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+
+inline MazeRandom::result_type MazeRandom::operator()()
+{
+    std::uint64_t result = rotate(s[1] * 5, 7) * 9;
+    std::uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotate(s[3], 45);
+    return result;
+}
+
+
+inline std::uint32_t MazeRandom::below(std::uint32_t bound)
+{
+    if (bound <= 1)
+    {
+        return 0;
+    }
+    std::uint32_t mask = bound - 1;
+    mask |= mask >> 1;
+    mask |= mask >> 2;
+    mask |= mask >> 4;
+    mask |= mask >> 8;
+    mask |= mask >> 16;
+    while (true)
+    {
+        std::uint64_t bits = (*this)();
+        std::uint32_t value = static_cast<std::uint32_t>(bits >> 32) & mask;
+        if (value < bound)
+        {
+            return value;
+        }
+        value = static_cast<std::uint32_t>(bits) & mask;
+        if (value < bound)
+        {
+            return value;
+        }
+    }
+}
+
+
+inline bool MazeRandom::coin()
+{
+    if (coinsLeft == 0)
+    {
+        coinBits = (*this)();
+        coinsLeft = 64;
+    }
+    bool heads = coinBits & 1;
+    coinBits >>= 1;
+    coinsLeft--;
+    return heads;
+}
+
+
+inline void MazeRandom::jump()
+{
+    static constexpr std::uint64_t polynomial[4] =
+    {
+        0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c
+    };
+    std::uint64_t jumped[4] = {0, 0, 0, 0};
+    for (std::uint64_t word : polynomial)
+    {
+        for (int bit = 0; bit < 64; bit++)
+        {
+            if (word & (std::uint64_t{1} << bit))
+            {
+                for (int i = 0; i < 4; i++)
+                {
+                    jumped[i] ^= s[i];
+                }
+            }
+            (*this)();
+        }
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        s[i] = jumped[i];
+    }
+    coinBits = 0;
+    coinsLeft = 0;
+}
+
+
+#endif
@@ -0,0 +1,91 @@
+// MazeRandom_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks that seeded sequences repeat, that below() stays in range and
+// spreads its draws evenly, and that jumped streams part ways.
+
+#include <gtest/gtest.h>
+#include "MazeRandom.hpp"
+#include <vector>
+
+
+TEST(MazeRandom_SanityCheckTests, sameSeedGivesTheSameSequence)
+{
+    MazeRandom a{12};
+    MazeRandom b{12};
+    MazeRandom c{13};
+    bool differs = false;
+    for (int i = 0; i < 100; i++)
+    {
+        std::uint64_t draw = a();
+        EXPECT_EQ(draw, b());
+        differs = differs || draw != c();
+    }
+    EXPECT_TRUE(differs);
+
+    std::uint64_t first = a();
+    a.seed(12);
+    b.seed(12);
+    for (int i = 0; i < 100; i++)
+    {
+        b();
+    }
+    EXPECT_EQ(b(), first);
+}
+
+
+TEST(MazeRandom_SanityCheckTests, belowStaysInRangeAndIsEven)
+{
+    MazeRandom random{14};
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(0u, random.below(1));
+    }
+
+    const std::uint32_t bound = 6;
+    const int draws = 60000;
+    std::vector<int> count(bound, 0);
+    for (int i = 0; i < draws; i++)
+    {
+        std::uint32_t value = random.below(bound);
+        ASSERT_LT(value, bound);
+        count[value]++;
+    }
+    for (int hits : count)
+    {
+        EXPECT_NEAR(draws / bound, hits, 600);
+    }
+}
+
+
+TEST(MazeRandom_SanityCheckTests, coinLandsBothWays)
+{
+    MazeRandom random{15};
+    int heads = 0;
+    for (int i = 0; i < 10000; i++)
+    {
+        heads += random.coin();
+    }
+    EXPECT_NEAR(5000, heads, 300);
+}
+
+
+TEST(MazeRandom_SanityCheckTests, jumpedStreamsPartWays)
+{
+    MazeRandom original{16};
+    MazeRandom jumped = original;
+    jumped.jump();
+    MazeRandom jumpedAgain = original;
+    jumpedAgain.jump();
+
+    bool differs = false;
+    for (int i = 0; i < 100; i++)
+    {
+        std::uint64_t draw = jumped();
+        EXPECT_EQ(draw, jumpedAgain());
+        differs = differs || draw != original();
+    }
+    EXPECT_TRUE(differs);
+}
@@ -0,0 +1,207 @@
+#ifndef MAZESANITYCHECKS_HPP
+#define MAZESANITYCHECKS_HPP
+
+#include "Maze.hpp"
+#include "MazeFactory.hpp"
+#include "MazeGenerator.hpp"
+#include "MazeSolution.hpp"
+#include "myMazeGenerator.hpp"
+#include "Direction.hpp"
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Checks shared by the *_SanityCheckTests.cpp files: whether a maze is
+// perfect, whether a list of moves is a real route through it, and a few
+// small helpers for making mazes and scratch files.
+namespace MazeSanityChecks
+{
+    const int WIDTH = 37;
+    const int HEIGHT = 23;
+
+    // A perfect maze has every cell reachable from (0, 0) and exactly one
+    // fewer open wall than cells, so it has no loops either.
+    bool isPerfect(const Maze& maze);
+
+    // Walks the moves from start and checks that no wall is crossed, no
+    // move leaves the maze and the walk finishes on end.
+    bool isRoute(const Maze& maze, std::pair<int,int> start, std::pair<int,int> end,
+                 const std::vector<Direction>& moves);
+
+    bool solvedCorrectly(const Maze& maze, const MazeSolution& solution);
+
+    bool sameWalls(const Maze& a, const Maze& b);
+
+    std::unique_ptr<Maze> generated(MazeGenerator& generator, int width = WIDTH, int height = HEIGHT);
+
+    // A WIDTH by HEIGHT perfect maze from the default generator.
+    std::unique_ptr<Maze> perfectMaze(uint64_t seed);
+
+    // An open WIDTH by HEIGHT maze crossed by a wall every fourth row, each
+    // with its gap in the last column, so it is full of loops and the
+    // shortest route from (0, 0) to the far corner is WIDTH+HEIGHT-2 moves.
+    std::unique_ptr<Maze> bandedMaze();
+
+    std::string contentsOf(const std::string& path);
+
+    // A directory under /tmp named after the test and this process.
+    std::string temporaryDirectory(const std::string& name);
+}
+
+
+inline bool MazeSanityChecks::isPerfect(const Maze& maze)
+{
+    int width = maze.getWidth();
+    int height = maze.getHeight();
+    long long openWalls = 0;
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            openWalls += x+1 < width && !maze.wallExists(x, y, Direction::right);
+            openWalls += y+1 < height && !maze.wallExists(x, y, Direction::down);
+        }
+    }
+
+    std::vector<bool> seen(static_cast<size_t>(width) * height, false);
+    std::vector<std::pair<int,int>> stack{{0, 0}};
+    seen[0] = true;
+    long long reached = 1;
+    while (!stack.empty())
+    {
+        int x = stack.back().first;
+        int y = stack.back().second;
+        stack.pop_back();
+        const std::pair<Direction, std::pair<int,int>> moves[] = {
+            {Direction::up, {x, y-1}}, {Direction::down, {x, y+1}},
+            {Direction::left, {x-1, y}}, {Direction::right, {x+1, y}}};
+        for (const auto& move : moves)
+        {
+            int xc = move.second.first;
+            int yc = move.second.second;
+            if (xc < 0 || yc < 0 || xc >= width || yc >= height
+                || maze.wallExists(x, y, move.first) || seen[static_cast<size_t>(yc) * width + xc])
+            {
+                continue;
+            }
+            seen[static_cast<size_t>(yc) * width + xc] = true;
+            reached++;
+            stack.push_back({xc, yc});
+        }
+    }
+    return reached == static_cast<long long>(width) * height
+        && openWalls == static_cast<long long>(width) * height - 1;
+}
+
+
+inline bool MazeSanityChecks::isRoute(const Maze& maze, std::pair<int,int> start, std::pair<int,int> end,
+                                      const std::vector<Direction>& moves)
+{
+    int x = start.first;
+    int y = start.second;
+    for (Direction direction : moves)
+    {
+        if (maze.wallExists(x, y, direction))
+        {
+            return false;
+        }
+        switch (direction)
+        {
+        case Direction::up:    y--; break;
+        case Direction::down:  y++; break;
+        case Direction::left:  x--; break;
+        case Direction::right: x++; break;
+        }
+        if (x < 0 || y < 0 || x >= maze.getWidth() || y >= maze.getHeight())
+        {
+            return false;
+        }
+    }
+    return x == end.first && y == end.second;
+}
+
+
+inline bool MazeSanityChecks::solvedCorrectly(const Maze& maze, const MazeSolution& solution)
+{
+    return solution.isComplete()
+        && isRoute(maze, solution.getStartingCell(), solution.getEndingCell(),
+                   solution.getMovements());
+}
+
+
+inline bool MazeSanityChecks::sameWalls(const Maze& a, const Maze& b)
+{
+    if (a.getWidth() != b.getWidth() || a.getHeight() != b.getHeight())
+    {
+        return false;
+    }
+    for (int y = 0; y < a.getHeight(); y++)
+    {
+        for (int x = 0; x < a.getWidth(); x++)
+        {
+            if (a.wallExists(x, y, Direction::right) != b.wallExists(x, y, Direction::right)
+                || a.wallExists(x, y, Direction::down) != b.wallExists(x, y, Direction::down))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+inline std::unique_ptr<Maze> MazeSanityChecks::generated(MazeGenerator& generator, int width, int height)
+{
+    std::unique_ptr<Maze> maze = MazeFactory{}.createMaze(width, height);
+    generator.generateMaze(*maze);
+    return maze;
+}
+
+
+inline std::unique_ptr<Maze> MazeSanityChecks::perfectMaze(uint64_t seed)
+{
+    myMazeGenerator generator;
+    generator.setSeed(seed);
+    return generated(generator);
+}
+
+
+inline std::unique_ptr<Maze> MazeSanityChecks::bandedMaze()
+{
+    std::unique_ptr<Maze> maze = MazeFactory{}.createMaze(WIDTH, HEIGHT);
+    maze->removeAllWalls();
+    for (int y = 2; y < HEIGHT; y += 4)
+    {
+        for (int x = 0; x+1 < WIDTH; x++)
+        {
+            maze->addWall(x, y, Direction::down);
+        }
+    }
+    return maze;
+}
+
+
+inline std::string MazeSanityChecks::contentsOf(const std::string& path)
+{
+    std::ifstream in{path, std::ios::binary};
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+
+inline std::string MazeSanityChecks::temporaryDirectory(const std::string& name)
+{
+    std::string directory = "/tmp/" + name + "-" + std::to_string(getpid());
+    mkdir(directory.c_str(), 0755);
+    return directory;
+}
+
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef MAZESEARCH_HPP
+#define MAZESEARCH_HPP
+
+#include "Direction.hpp"
+#include "Maze.hpp"
+#include "MazeSolution.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Small helpers shared by the search-based solvers.  Cells are numbered
+// row-major (y * width + x) so per-cell state can live in flat arrays,
+// and the route to a cell is remembered as the Direction that entered it.
+namespace MazeSearch
+{
+    const Direction directions[4] = {
+        Direction::up, Direction::down, Direction::left, Direction::right
+    };
+
+    inline std::size_t cellIndex(int x, int y, int width)
+    {
+        return static_cast<std::size_t>(y) * width + x;
+    }
+
+    inline void step(Direction direction, int& x, int& y)
+    {
+        switch (direction)
+        {
+        case Direction::up:
+            y--;
+            break;
+        case Direction::down:
+            y++;
+            break;
+        case Direction::left:
+            x--;
+            break;
+        case Direction::right:
+            x++;
+            break;
+        }
+    }
+
+    inline Direction opposite(Direction direction)
+    {
+        switch (direction)
+        {
+        case Direction::up:
+            return Direction::down;
+        case Direction::down:
+            return Direction::up;
+        case Direction::left:
+            return Direction::right;
+        default:
+            return Direction::left;
+        }
+    }
+
+    // canMove() is true when (x, y) has a neighbour in that direction and
+    // no wall between them.  Grid is a Maze or anything else with the same
+    // getWidth(), getHeight() and wallExists(), such as a MazeBitboard.
+    template <typename Grid>
+    inline bool canMove(const Grid& maze, int x, int y, Direction direction)
+    {
+        int xc = x;
+        int yc = y;
+        step(direction, xc, yc);
+        return xc >= 0 && yc >= 0 && xc < maze.getWidth() && yc < maze.getHeight()
+            && !maze.wallExists(x, y, direction);
+    }
+
+    // A quarter turn clockwise or anticlockwise, as seen on screen with y
+    // growing downwards.
+    inline Direction turnRight(Direction direction)
+    {
+        switch (direction)
+        {
+        case Direction::up:
+            return Direction::right;
+        case Direction::right:
+            return Direction::down;
+        case Direction::down:
+            return Direction::left;
+        default:
+            return Direction::up;
+        }
+    }
+
+    inline Direction turnLeft(Direction direction)
+    {
+        return opposite(turnRight(direction));
+    }
+
+    // Walks back from end to start following the entering directions in
+    // cameFrom[] and leaves the forward route in path.
+    inline void tracePath(
+        const std::vector<unsigned char>& cameFrom, int width,
+        std::pair<int, int> start, std::pair<int, int> end,
+        std::vector<Direction>& path)
+    {
+        path.clear();
+        int x = end.first;
+        int y = end.second;
+        while (x != start.first || y != start.second)
+        {
+            Direction direction = static_cast<Direction>(cameFrom[cellIndex(x, y, width)]);
+            path.push_back(direction);
+            step(opposite(direction), x, y);
+        }
+        std::reverse(path.begin(), path.end());
+    }
+
+    // Searches that can be cancelled take a pointer to a flag set by
+    // another thread, and poll it once every CANCEL_POLL_INTERVAL cells so
+    // the atomic load stays off the hot path.  A null flag never cancels.
+    constexpr std::size_t CANCEL_POLL_INTERVAL = 1024;
+
+    inline bool cancelled(const std::atomic<bool>* cancel)
+    {
+        return cancel != nullptr && cancel->load(std::memory_order_relaxed);
+    }
+
+    inline void writePath(const std::vector<Direction>& path, MazeSolution& mazeSolution)
+    {
+        mazeSolution.restart();
+        for (Direction direction : path)
+        {
+            mazeSolution.extend(direction);
+        }
+    }
+}
+
+#endif
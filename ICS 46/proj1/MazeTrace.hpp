@@ -0,0 +1,199 @@
+#ifndef MAZETRACE_HPP
+#define MAZETRACE_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+// Tracing for the maze generators and solvers.
+//
+// MAZE_TRACE_LEVEL picks what gets recorded and is fixed at compile time:
+//
+//     0  nothing (the default); every MAZE_TRACE_* macro expands to nothing
+//     1  phases: a run starting and finishing
+//     2  phases and every step: cells visited, backtracks, solver moves
+//
+// Build with -DMAZE_TRACE_LEVEL=2 to turn it on.  Events are collected in
+// a per-thread buffer and only written out when the buffer fills, a run
+// finishes (generateEnd or solveEnd) or MazeTrace::flush() is called, so
+// tracing doesn't flush the output once per cell.  Output goes to
+// std::cerr as one text line per event unless setOutput() picks another
+// stream or the raw 16-byte Event records.
+
+#ifndef MAZE_TRACE_LEVEL
+#define MAZE_TRACE_LEVEL 0
+#endif
+
+namespace MazeTrace
+{
+    enum class Kind : std::int32_t
+    {
+        generateBegin,
+        generateEnd,
+        generateVisit,
+        generateBacktrack,
+        solveBegin,
+        solveEnd,
+        solveStep,
+        solveBackUp
+    };
+
+    struct Event
+    {
+        Kind kind;
+        std::int32_t x;
+        std::int32_t y;
+        std::int32_t value;
+    };
+
+    enum class Format { text, binary };
+
+    const char* kindName(Kind kind);
+
+    // setOutput() flushes the calling thread and sends every later flush
+    // to out; pass nullptr to drop events instead.  Call setOutput(nullptr)
+    // before out goes away.
+    void setOutput(std::ostream* out, Format format = Format::text);
+
+    void record(Kind kind, int x, int y, int value);
+
+    // flush() writes out the calling thread's buffered events and flushes
+    // the stream they went to.
+    void flush();
+
+
+    namespace detail
+    {
+        constexpr std::size_t BUFFER_EVENTS = 4096;
+
+        struct Sink
+        {
+            std::mutex lock;
+            std::ostream* out = &std::cerr;
+            Format format = Format::text;
+        };
+
+        inline Sink& sink()
+        {
+            static Sink s;
+            return s;
+        }
+
+        struct Buffer
+        {
+            std::vector<Event> events;
+
+            Buffer()
+            {
+                events.reserve(BUFFER_EVENTS);
+            }
+
+            ~Buffer()
+            {
+                write();
+            }
+
+            void write()
+            {
+                Sink& s = sink();
+                std::lock_guard<std::mutex> guard{s.lock};
+                if (s.out != nullptr && s.format == Format::binary)
+                {
+                    s.out->write(reinterpret_cast<const char*>(events.data()),
+                        events.size() * sizeof(Event));
+                }
+                else if (s.out != nullptr)
+                {
+                    for (const Event& event : events)
+                    {
+                        *s.out << kindName(event.kind) << ' ' << event.x << ' '
+                               << event.y << ' ' << event.value << '\n';
+                    }
+                }
+                if (s.out != nullptr)
+                {
+                    s.out->flush();
+                }
+                events.clear();
+            }
+        };
+
+        inline Buffer& buffer()
+        {
+            thread_local Buffer b;
+            return b;
+        }
+    }
+
+
+    inline const char* kindName(Kind kind)
+    {
+        switch (kind)
+        {
+        case Kind::generateBegin:
+            return "generateBegin";
+        case Kind::generateEnd:
+            return "generateEnd";
+        case Kind::generateVisit:
+            return "generateVisit";
+        case Kind::generateBacktrack:
+            return "generateBacktrack";
+        case Kind::solveBegin:
+            return "solveBegin";
+        case Kind::solveEnd:
+            return "solveEnd";
+        case Kind::solveStep:
+            return "solveStep";
+        default:
+            return "solveBackUp";
+        }
+    }
+
+
+    inline void setOutput(std::ostream* out, Format format)
+    {
+        flush();
+        detail::Sink& s = detail::sink();
+        std::lock_guard<std::mutex> guard{s.lock};
+        s.out = out;
+        s.format = format;
+    }
+
+
+    inline void record(Kind kind, int x, int y, int value)
+    {
+        detail::Buffer& b = detail::buffer();
+        b.events.push_back({kind, x, y, value});
+        if (b.events.size() == detail::BUFFER_EVENTS
+            || kind == Kind::generateEnd || kind == Kind::solveEnd)
+        {
+            b.write();
+        }
+    }
+
+
+    inline void flush()
+    {
+        detail::buffer().write();
+    }
+}
+
+
+#if MAZE_TRACE_LEVEL >= 1
+#define MAZE_TRACE_PHASE(kind, x, y, value) \
+    ::MazeTrace::record(::MazeTrace::Kind::kind, (x), (y), static_cast<int>(value))
+#else
+#define MAZE_TRACE_PHASE(kind, x, y, value) ((void)0)
+#endif
+
+#if MAZE_TRACE_LEVEL >= 2
+#define MAZE_TRACE_STEP(kind, x, y, value) \
+    ::MazeTrace::record(::MazeTrace::Kind::kind, (x), (y), static_cast<int>(value))
+#else
+#define MAZE_TRACE_STEP(kind, x, y, value) ((void)0)
+#endif
+
+
+#endif
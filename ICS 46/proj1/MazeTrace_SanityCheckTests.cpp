@@ -0,0 +1,71 @@
+// MazeTrace_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks what tracing writes out and when.  This file turns every trace
+// macro on for itself; the rest of the build keeps its own level.
+
+#define MAZE_TRACE_LEVEL 2
+
+#include <gtest/gtest.h>
+#include "MazeTrace.hpp"
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+
+TEST(MazeTrace_SanityCheckTests, writesToStandardErrorByDefault)
+{
+    std::ostringstream captured;
+    std::streambuf* original = std::cerr.rdbuf(captured.rdbuf());
+    MAZE_TRACE_PHASE(generateEnd, 1, 2, 3);
+    std::cerr.rdbuf(original);
+    EXPECT_EQ("generateEnd 1 2 3\n", captured.str());
+}
+
+
+TEST(MazeTrace_SanityCheckTests, recordsStepsAsTextLines)
+{
+    std::ostringstream out;
+    MazeTrace::setOutput(&out);
+    MAZE_TRACE_PHASE(solveBegin, 0, 0, 0);
+    MAZE_TRACE_STEP(solveStep, 1, 0, 2);
+    MAZE_TRACE_STEP(solveBackUp, 1, 0, 0);
+    EXPECT_EQ("", out.str());
+
+    MAZE_TRACE_PHASE(solveEnd, 4, 5, 9);
+    EXPECT_EQ("solveBegin 0 0 0\nsolveStep 1 0 2\nsolveBackUp 1 0 0\nsolveEnd 4 5 9\n", out.str());
+    MazeTrace::setOutput(&std::cerr);
+}
+
+
+TEST(MazeTrace_SanityCheckTests, flushWritesWhatIsBuffered)
+{
+    std::ostringstream out;
+    MazeTrace::setOutput(&out);
+    MAZE_TRACE_STEP(generateVisit, 2, 3, 1);
+    MazeTrace::flush();
+    EXPECT_EQ("generateVisit 2 3 1\n", out.str());
+    MazeTrace::setOutput(&std::cerr);
+}
+
+
+TEST(MazeTrace_SanityCheckTests, binaryOutputIsTheRawEvents)
+{
+    std::ostringstream out;
+    MazeTrace::setOutput(&out, MazeTrace::Format::binary);
+    MAZE_TRACE_STEP(generateBacktrack, 6, 7, 8);
+    MAZE_TRACE_PHASE(generateEnd, 10, 11, 1);
+    MazeTrace::setOutput(&std::cerr);
+
+    std::string bytes = out.str();
+    ASSERT_EQ(2 * sizeof(MazeTrace::Event), bytes.size());
+    MazeTrace::Event event;
+    std::memcpy(&event, bytes.data(), sizeof(event));
+    EXPECT_EQ(MazeTrace::Kind::generateBacktrack, event.kind);
+    EXPECT_EQ(6, event.x);
+    EXPECT_EQ(7, event.y);
+    EXPECT_EQ(8, event.value);
+}
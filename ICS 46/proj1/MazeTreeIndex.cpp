@@ -0,0 +1,210 @@
+#include "MazeTreeIndex.hpp"
+#include "MazeSearch.hpp"
+#include "BitGrid.hpp"
+#include <algorithm>
+using namespace std;
+
+namespace
+{
+    int floorLog2(size_t n)
+    {
+        int log = 0;
+        while (n >>= 1)
+        {
+            log++;
+        }
+        return log;
+    }
+}
+
+bool MazeTreeIndex::build(const Maze& maze,pair<int,int> root)
+{
+    width = maze.getWidth();
+    height = maze.getHeight();
+    size_t cells = static_cast<size_t>(width) * height;
+    cameFrom.assign(cells, 0);
+    cellDepth.assign(cells, -1);
+    firstVisit.assign(cells, 0);
+    euler.clear();
+    euler.reserve(2 * cells);
+
+    // Depth-first walk on an explicit stack.  Each entry is a cell and the
+    // next of its four directions to try; the cell is appended to the tour
+    // when it is entered and again each time the walk returns to it.
+    BitGrid visit{width, height};
+    vector<pair<int32_t,int>> stack;
+    size_t treeEdges = 0;
+    size_t edges = 0;
+
+    int first = static_cast<int>(MazeSearch::cellIndex(root.first,root.second,width));
+    visit.set(root.first,root.second);
+    cellDepth[first] = 0;
+    firstVisit[first] = 0;
+    euler.push_back(first);
+    stack.push_back({first,0});
+    while (stack.size() > 0)
+    {
+        int cell = stack.back().first;
+        int& next = stack.back().second;
+        if (next == 4)
+        {
+            stack.pop_back();
+            if (stack.size() > 0)
+            {
+                euler.push_back(stack.back().first);
+            }
+            continue;
+        }
+
+        Direction direction = MazeSearch::directions[next++];
+        int x = cell % width;
+        int y = cell / width;
+        if (!MazeSearch::canMove(maze,x,y,direction))
+        {
+            continue;
+        }
+        edges++;
+        int xc = x;
+        int yc = y;
+        MazeSearch::step(direction,xc,yc);
+        if (visit.testAndSet(xc,yc))
+        {
+            continue;
+        }
+        treeEdges++;
+        int child = static_cast<int>(MazeSearch::cellIndex(xc,yc,width));
+        cameFrom[child] = static_cast<unsigned char>(direction);
+        cellDepth[child] = cellDepth[cell] + 1;
+        firstVisit[child] = static_cast<int32_t>(euler.size());
+        euler.push_back(child);
+        stack.push_back({child,0});
+    }
+
+    size_t tour = euler.size();
+    int levels = floorLog2(tour) + 1;
+    levelStart.assign(levels, 0);
+    table.resize(tour * levels);
+    copy(euler.begin(), euler.end(), table.begin());
+    for (int k = 1; k < levels; k++)
+    {
+        levelStart[k] = levelStart[k-1] + tour;
+        size_t half = size_t{1} << (k-1);
+        for (size_t i = 0; i + 2 * half <= tour; i++)
+        {
+            table[levelStart[k] + i] = shallower(
+                table[levelStart[k-1] + i], table[levelStart[k-1] + i + half]);
+        }
+    }
+
+    // Every open wall is seen once from each side.
+    return treeEdges + 1 == cells && edges == 2 * treeEdges;
+}
+
+int MazeTreeIndex::getWidth() const
+{
+    return width;
+}
+
+int MazeTreeIndex::getHeight() const
+{
+    return height;
+}
+
+int MazeTreeIndex::cellOf(pair<int,int> cell) const
+{
+    return static_cast<int>(MazeSearch::cellIndex(cell.first,cell.second,width));
+}
+
+int MazeTreeIndex::shallower(int a,int b) const
+{
+    return cellDepth[b] < cellDepth[a] ? b : a;
+}
+
+int MazeTreeIndex::lca(int a,int b) const
+{
+    size_t from = firstVisit[a];
+    size_t to = firstVisit[b];
+    if (from > to)
+    {
+        swap(from, to);
+    }
+    int k = floorLog2(to - from + 1);
+    size_t span = size_t{1} << k;
+    return shallower(table[levelStart[k] + from], table[levelStart[k] + to + 1 - span]);
+}
+
+bool MazeTreeIndex::isReachable(pair<int,int> cell) const
+{
+    return cellDepth[cellOf(cell)] >= 0;
+}
+
+int MazeTreeIndex::depth(pair<int,int> cell) const
+{
+    return cellDepth[cellOf(cell)];
+}
+
+pair<int,int> MazeTreeIndex::lowestCommonAncestor(pair<int,int> a,pair<int,int> b) const
+{
+    if (!isReachable(a) || !isReachable(b))
+    {
+        return {-1,-1};
+    }
+    int cell = lca(cellOf(a), cellOf(b));
+    return {cell % width, cell / width};
+}
+
+int MazeTreeIndex::pathLength(pair<int,int> a,pair<int,int> b) const
+{
+    int cellA = cellOf(a);
+    int cellB = cellOf(b);
+    if (cellDepth[cellA] < 0 || cellDepth[cellB] < 0)
+    {
+        return -1;
+    }
+    return cellDepth[cellA] + cellDepth[cellB] - 2 * cellDepth[lca(cellA,cellB)];
+}
+
+// Climbs from a up to the common ancestor, then appends the climb from b
+// reversed, which is the way back down to b.
+bool MazeTreeIndex::path(pair<int,int> a,pair<int,int> b,vector<Direction>& path) const
+{
+    path.clear();
+    if (!isReachable(a) || !isReachable(b))
+    {
+        return false;
+    }
+    int top = lca(cellOf(a), cellOf(b));
+    pair<int,int> ancestor{top % width, top / width};
+
+    int x = a.first;
+    int y = a.second;
+    while (x != ancestor.first || y != ancestor.second)
+    {
+        Direction up = MazeSearch::opposite(static_cast<Direction>(cameFrom[MazeSearch::cellIndex(x,y,width)]));
+        path.push_back(up);
+        MazeSearch::step(up,x,y);
+    }
+
+    size_t down = path.size();
+    x = b.first;
+    y = b.second;
+    while (x != ancestor.first || y != ancestor.second)
+    {
+        Direction entered = static_cast<Direction>(cameFrom[MazeSearch::cellIndex(x,y,width)]);
+        path.push_back(entered);
+        MazeSearch::step(MazeSearch::opposite(entered),x,y);
+    }
+    reverse(path.begin() + down, path.end());
+    return true;
+}
+
+bool MazeTreeIndex::writePath(MazeSolution& mazeSolution) const
+{
+    vector<Direction> route;
+    if (!path(mazeSolution.getStartingCell(), mazeSolution.getEndingCell(), route))
+    {
+        return false;
+    }
+    MazeSearch::writePath(route, mazeSolution);
+    return true;
+}
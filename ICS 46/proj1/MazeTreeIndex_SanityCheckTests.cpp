@@ -0,0 +1,70 @@
+// MazeTreeIndex_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks the tree index's routes against breadth-first search, and that
+// it refuses to answer for cells the root can't reach.
+
+#include <gtest/gtest.h>
+#include "MazeTreeIndex.hpp"
+#include "MazeSolutionFactory.hpp"
+#include "myBFSMazeSolver.hpp"
+#include "MazeSanityChecks.hpp"
+#include <vector>
+
+using namespace MazeSanityChecks;
+
+
+TEST(MazeTreeIndex_SanityCheckTests, matchesBreadthFirstRoutes)
+{
+    std::unique_ptr<Maze> maze = perfectMaze(8);
+    MazeTreeIndex index;
+    ASSERT_TRUE(index.build(*maze));
+
+    myBFSMazeSolver bfs;
+    std::vector<Direction> expected;
+    std::vector<Direction> path;
+    for (int y = 0; y < HEIGHT; y++)
+    {
+        for (int x = 0; x < WIDTH; x++)
+        {
+            ASSERT_TRUE(bfs.findPath(*maze, {3, 4}, {x, y}, expected));
+            EXPECT_EQ(static_cast<int>(expected.size()), index.pathLength({3, 4}, {x, y}));
+            EXPECT_TRUE(index.path({3, 4}, {x, y}, path));
+            EXPECT_EQ(expected, path);
+        }
+    }
+}
+
+
+TEST(MazeTreeIndex_SanityCheckTests, writesACompleteSolution)
+{
+    std::unique_ptr<Maze> maze = perfectMaze(9);
+    MazeTreeIndex index;
+    ASSERT_TRUE(index.build(*maze, {WIDTH/2, HEIGHT/2}));
+    EXPECT_EQ(0, index.depth({WIDTH/2, HEIGHT/2}));
+
+    std::unique_ptr<MazeSolution> solution = MazeSolutionFactory{}.createMazeSolution(WIDTH, HEIGHT);
+    EXPECT_TRUE(index.writePath(*solution));
+    EXPECT_TRUE(solvedCorrectly(*maze, *solution));
+}
+
+
+TEST(MazeTreeIndex_SanityCheckTests, reportsUnreachableCells)
+{
+    std::unique_ptr<Maze> maze = MazeFactory{}.createMaze(4, 4);
+    maze->addAllWalls();
+    maze->removeWall(0, 0, Direction::right);
+    MazeTreeIndex index;
+    EXPECT_FALSE(index.build(*maze));
+    EXPECT_TRUE(index.isReachable({1, 0}));
+    EXPECT_FALSE(index.isReachable({3, 3}));
+    EXPECT_EQ(1, index.pathLength({0, 0}, {1, 0}));
+    EXPECT_EQ(-1, index.pathLength({0, 0}, {3, 3}));
+    EXPECT_EQ(-1, index.depth({3, 3}));
+    EXPECT_EQ(std::make_pair(-1, -1), index.lowestCommonAncestor({0, 0}, {3, 3}));
+    std::vector<Direction> path;
+    EXPECT_FALSE(index.path({0, 0}, {3, 3}, path));
+    EXPECT_TRUE(path.empty());
+}
@@ -0,0 +1,58 @@
+#ifndef MORTONORDER_HPP
+#define MORTONORDER_HPP
+
+#include <cstdint>
+
+// Morton (Z-order) numbering of grid cells: the bits of x and y are
+// interleaved, x in the even bits and y in the odd ones.  Cells that are
+// close in both directions get close numbers, so a walk that moves up and
+// down as often as sideways stays within a few cache lines, where in
+// row-major order every vertical step jumps a whole row.
+//
+// A neighbour's number comes straight from the cell's own: to add or
+// subtract one from x, fill the y bits with ones (or clear them) so the
+// carry or borrow runs through them, then put the y bits back.
+namespace MortonOrder
+{
+    constexpr std::uint64_t X_BITS = 0x5555555555555555;
+    constexpr std::uint64_t Y_BITS = 0xaaaaaaaaaaaaaaaa;
+
+    // spread() moves bit i of value to bit 2i.
+    inline std::uint64_t spread(std::uint32_t value)
+    {
+        std::uint64_t v = value;
+        v = (v | (v << 16)) & 0x0000ffff0000ffff;
+        v = (v | (v << 8)) & 0x00ff00ff00ff00ff;
+        v = (v | (v << 4)) & 0x0f0f0f0f0f0f0f0f;
+        v = (v | (v << 2)) & 0x3333333333333333;
+        v = (v | (v << 1)) & 0x5555555555555555;
+        return v;
+    }
+
+    inline std::uint64_t encode(std::uint32_t x, std::uint32_t y)
+    {
+        return spread(x) | (spread(y) << 1);
+    }
+
+    inline std::uint64_t nextX(std::uint64_t z)
+    {
+        return (((z | Y_BITS) + 1) & X_BITS) | (z & Y_BITS);
+    }
+
+    inline std::uint64_t previousX(std::uint64_t z)
+    {
+        return (((z & X_BITS) - 1) & X_BITS) | (z & Y_BITS);
+    }
+
+    inline std::uint64_t nextY(std::uint64_t z)
+    {
+        return (((z | X_BITS) + 2) & Y_BITS) | (z & X_BITS);
+    }
+
+    inline std::uint64_t previousY(std::uint64_t z)
+    {
+        return (((z & Y_BITS) - 2) & Y_BITS) | (z & X_BITS);
+    }
+}
+
+#endif
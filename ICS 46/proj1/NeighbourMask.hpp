@@ -0,0 +1,187 @@
+#ifndef NEIGHBOURMASK_HPP
+#define NEIGHBOURMASK_HPP
+
+#include "BitGrid.hpp"
+#include "Direction.hpp"
+#include "Maze.hpp"
+#include "MazeBitboard.hpp"
+#include "MazeRandom.hpp"
+#include <cstdint>
+#include <cstring>
+
+// Neighbour enumeration without building a vector<Direction>.  The four
+// neighbours of a cell are one bit each in a 4-bit mask, so "unvisited
+// and not walled off" is an AND of two masks and picking a random
+// neighbour is a popcount and a bit select.
+namespace NeighbourMask
+{
+    constexpr unsigned int UP = 1;
+    constexpr unsigned int DOWN = 2;
+    constexpr unsigned int LEFT = 4;
+    constexpr unsigned int RIGHT = 8;
+    constexpr unsigned int ALL = UP | DOWN | LEFT | RIGHT;
+
+    // Indexed by bit position.
+    const Direction directions[4] = {
+        Direction::up, Direction::down, Direction::left, Direction::right
+    };
+
+    inline unsigned int bit(Direction direction)
+    {
+        switch (direction)
+        {
+        case Direction::up:
+            return UP;
+        case Direction::down:
+            return DOWN;
+        case Direction::left:
+            return LEFT;
+        default:
+            return RIGHT;
+        }
+    }
+
+    inline int count(unsigned int mask)
+    {
+        return __builtin_popcount(mask);
+    }
+
+    // Neighbours inside the grid that aren't set in visit.  Coordinates
+    // are clamped instead of branched on, so the probe for a missing
+    // neighbour reads the cell itself and is then masked away.  In Z-order
+    // the cell is numbered once and its neighbours are stepped to from
+    // that number.
+    inline unsigned int unvisited(const BitGrid& visit, int x, int y)
+    {
+        unsigned int hasUp = y > 0;
+        unsigned int hasDown = y+1 < visit.getHeight();
+        unsigned int hasLeft = x > 0;
+        unsigned int hasRight = x+1 < visit.getWidth();
+        if (visit.getIndexLayout() == BitGrid::Layout::morton)
+        {
+            std::uint64_t z = visit.index(x, y);
+            return ((hasUp & !visit.testIndex(hasUp ? MortonOrder::previousY(z) : z)) * UP)
+                 | ((hasDown & !visit.testIndex(hasDown ? MortonOrder::nextY(z) : z)) * DOWN)
+                 | ((hasLeft & !visit.testIndex(hasLeft ? MortonOrder::previousX(z) : z)) * LEFT)
+                 | ((hasRight & !visit.testIndex(hasRight ? MortonOrder::nextX(z) : z)) * RIGHT);
+        }
+        return ((hasUp & !visit.test(x, y - hasUp)) * UP)
+             | ((hasDown & !visit.test(x, y + hasDown)) * DOWN)
+             | ((hasLeft & !visit.test(x - hasLeft, y)) * LEFT)
+             | ((hasRight & !visit.test(x + hasRight, y)) * RIGHT);
+    }
+
+    // Of the candidate neighbours, the ones with no wall in between.  Only
+    // the candidates are asked about, which saves virtual wallExists()
+    // calls for neighbours that were already ruled out.
+    inline unsigned int open(const Maze& maze, int x, int y, unsigned int candidates = ALL)
+    {
+        unsigned int mask = 0;
+        for (unsigned int rest = candidates; rest != 0; rest &= rest - 1)
+        {
+            int i = __builtin_ctz(rest);
+            mask |= static_cast<unsigned int>(!maze.wallExists(x, y, directions[i])) << i;
+        }
+        return mask;
+    }
+
+    // The same from a bitboard, where it is four bit extractions.  The
+    // outer walls are stored as set bits, so no bounds checks are needed
+    // except above the first row and left of the first column.
+    inline unsigned int open(const MazeBitboard& bitboard, int x, int y)
+    {
+        const uint64_t* right = bitboard.rightWalls(y);
+        const uint64_t* down = bitboard.downWalls(y);
+        unsigned int hasUp = y > 0;
+        unsigned int hasLeft = x > 0;
+        int left = x - hasLeft;
+        const uint64_t* above = bitboard.downWalls(y - hasUp);
+        return ((hasUp & ~(above[x >> 6] >> (x & 63))) & 1) * UP
+             | (~(down[x >> 6] >> (x & 63)) & 1) * DOWN
+             | ((hasLeft & ~(right[left >> 6] >> (left & 63))) & 1) * LEFT
+             | (~(right[x >> 6] >> (x & 63)) & 1) * RIGHT;
+    }
+
+    // pick() chooses one set bit of a non-empty mask uniformly at random.
+    inline Direction pick(unsigned int mask, MazeRandom& random)
+    {
+        for (unsigned int skip = random.below(count(mask)); skip > 0; skip--)
+        {
+            mask &= mask - 1;
+        }
+        return directions[__builtin_ctz(mask)];
+    }
+
+
+    namespace detail
+    {
+        // spread[b] has byte i equal to bit i of b, which turns 8 bits of
+        // one wall plane into 8 cells' worth of mask bits at once.
+        struct SpreadTable
+        {
+            uint64_t spread[256];
+
+            SpreadTable()
+            {
+                for (int b = 0; b < 256; b++)
+                {
+                    spread[b] = 0;
+                    for (int i = 0; i < 8; i++)
+                    {
+                        spread[b] |= static_cast<uint64_t>((b >> i) & 1) << (8 * i);
+                    }
+                }
+            }
+        };
+
+        inline const SpreadTable& spreadTable()
+        {
+            static const SpreadTable table;
+            return table;
+        }
+    }
+
+
+    // openRow() fills masks[0..width) with the open-neighbour mask of every
+    // cell in row y.  Each 64-bit word of the wall planes gives 64 cells'
+    // open bits in four shifts and complements, and those are spread into
+    // bytes eight cells at a time within one 64-bit register (byte order
+    // assumes a little-endian machine).
+    inline void openRow(const MazeBitboard& bitboard, int y, unsigned char* masks)
+    {
+        const detail::SpreadTable& table = detail::spreadTable();
+        const uint64_t* right = bitboard.rightWalls(y);
+        const uint64_t* down = bitboard.downWalls(y);
+        const uint64_t* above = y > 0 ? bitboard.downWalls(y-1) : nullptr;
+        int width = bitboard.getWidth();
+        size_t words = bitboard.rowWords();
+
+        uint64_t carry = 1;
+        for (size_t w = 0; w < words; w++)
+        {
+            uint64_t openRight = ~right[w];
+            uint64_t openLeft = ~((right[w] << 1) | carry);
+            uint64_t openDown = ~down[w];
+            uint64_t openUp = above != nullptr ? ~above[w] : 0;
+            carry = right[w] >> 63;
+
+            for (int b = 0; b < 8; b++)
+            {
+                size_t first = w * 64 + b * 8;
+                if (first >= static_cast<size_t>(width))
+                {
+                    break;
+                }
+                int shift = b * 8;
+                uint64_t lanes = table.spread[(openUp >> shift) & 0xff]
+                               | table.spread[(openDown >> shift) & 0xff] << 1
+                               | table.spread[(openLeft >> shift) & 0xff] << 2
+                               | table.spread[(openRight >> shift) & 0xff] << 3;
+                size_t cells = width - first < 8 ? width - first : 8;
+                std::memcpy(masks + first, &lanes, cells);
+            }
+        }
+    }
+}
+
+#endif
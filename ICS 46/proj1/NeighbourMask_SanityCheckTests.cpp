@@ -0,0 +1,102 @@
+// NeighbourMask_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks the neighbour masks against asking the maze and the visit grid
+// one direction at a time.
+
+#include <gtest/gtest.h>
+#include "NeighbourMask.hpp"
+#include "MazeSanityChecks.hpp"
+#include <vector>
+
+using namespace MazeSanityChecks;
+
+
+namespace
+{
+    unsigned int expectedUnvisited(const BitGrid& visit, int x, int y)
+    {
+        unsigned int mask = 0;
+        mask |= (y > 0 && !visit.test(x, y-1)) * NeighbourMask::UP;
+        mask |= (y+1 < visit.getHeight() && !visit.test(x, y+1)) * NeighbourMask::DOWN;
+        mask |= (x > 0 && !visit.test(x-1, y)) * NeighbourMask::LEFT;
+        mask |= (x+1 < visit.getWidth() && !visit.test(x+1, y)) * NeighbourMask::RIGHT;
+        return mask;
+    }
+
+
+    unsigned int expectedOpen(const Maze& maze, int x, int y)
+    {
+        unsigned int mask = 0;
+        for (Direction direction : NeighbourMask::directions)
+        {
+            if (!maze.wallExists(x, y, direction))
+            {
+                mask |= NeighbourMask::bit(direction);
+            }
+        }
+        return mask;
+    }
+}
+
+
+TEST(NeighbourMask_SanityCheckTests, unvisitedMatchesTheVisitGrid)
+{
+    for (BitGrid::Layout layout : {BitGrid::Layout::rowMajor, BitGrid::Layout::morton})
+    {
+        BitGrid visit{9, 7, layout};
+        for (int i = 0; i < 63; i += 4)
+        {
+            visit.set(i % 9, i / 9);
+        }
+        for (int y = 0; y < 7; y++)
+        {
+            for (int x = 0; x < 9; x++)
+            {
+                EXPECT_EQ(expectedUnvisited(visit, x, y), NeighbourMask::unvisited(visit, x, y));
+            }
+        }
+    }
+}
+
+
+// 70 columns cross a word boundary in the bitboard's rows.
+TEST(NeighbourMask_SanityCheckTests, openMatchesTheWalls)
+{
+    myMazeGenerator generator;
+    generator.setSeed(12);
+    std::unique_ptr<Maze> maze = generated(generator, 70, 9);
+    MazeBitboard bitboard = MazeBitboard::fromMaze(*maze);
+    std::vector<unsigned char> row(70);
+    for (int y = 0; y < 9; y++)
+    {
+        NeighbourMask::openRow(bitboard, y, row.data());
+        for (int x = 0; x < 70; x++)
+        {
+            unsigned int expected = expectedOpen(*maze, x, y);
+            EXPECT_EQ(expected, NeighbourMask::open(*maze, x, y));
+            EXPECT_EQ(expected & NeighbourMask::LEFT,
+                      NeighbourMask::open(*maze, x, y, NeighbourMask::LEFT | NeighbourMask::UP) & NeighbourMask::LEFT);
+            EXPECT_EQ(expected, NeighbourMask::open(bitboard, x, y));
+            EXPECT_EQ(expected, row[x]);
+        }
+    }
+}
+
+
+TEST(NeighbourMask_SanityCheckTests, pickChoosesEverySetBit)
+{
+    MazeRandom random{13};
+    const unsigned int mask = NeighbourMask::UP | NeighbourMask::LEFT | NeighbourMask::RIGHT;
+    unsigned int seen = 0;
+    for (int i = 0; i < 200; i++)
+    {
+        unsigned int picked = NeighbourMask::bit(NeighbourMask::pick(mask, random));
+        EXPECT_NE(0u, picked & mask);
+        seen |= picked;
+    }
+    EXPECT_EQ(mask, seen);
+    EXPECT_EQ(3, NeighbourMask::count(mask));
+}
@@ -0,0 +1,1156 @@
+// expmain.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Do whatever you'd like here.  This is intended to allow you to experiment
+// with the given classes in the darkmaze library, or with your own
+// algorithm implementations, outside of the context of the GUI or
+// Google Test.
+//
+// Here it is a benchmark suite.  With no arguments it runs every generator
+// and solver over a matrix of square maze sizes and seeds and writes one
+// CSV line per run:
+//
+//     exp [--sizes 100,1000] [--seeds 1,2,3] [--repeat 3] [--out results.csv]
+//
+// Each run happens in a forked child so its peak resident set size is its
+// own; a run that crashes (the recursive generator on a big maze) shows up
+// with status "crashed" instead of stopping the suite.  Solver runs time
+// only the solve, on a maze made by the iterative generator from the same
+// seed.  Two result files from different builds can then be compared:
+//
+//     exp --compare before.csv after.csv [--threshold 0.05]
+//
+// which prints the throughput and memory ratio of every run both files
+// have and exits with 1 if any run got slower by more than the threshold.
+//
+// exp --micro runs the smaller experiments instead, in this order:
+//
+//   - the iterative generator's throughput at a few sizes
+//   - the old nested visited grid against BitGrid
+//   - a thread-count sweep of the parallel generator
+//   - how many cells each solver expands
+//   - MazeTreeIndex build and query times
+//   - a dead-end count with per-cell neighbour masks against row masks
+//   - a thread-count sweep of MazeBatchSolver on many small mazes
+//   - the wavefront solver against breadth-first search on an open maze,
+//     both searching alone and through solveMaze(), which for the
+//     wavefront solver includes building the bitboard
+//   - LPA* repairs after doors open against solving again with A*
+//   - the MazeCounters of every myMazeGenerator mode and of myMazeSolver,
+//     which only change when the algorithms do
+//   - MazeHierarchy queries against breadth-first search
+//   - row-major against Z-order visited grids, timed, with cache misses
+//     counted by perf_event_open() where the kernel allows it
+//   - how far time-sliced generation overshoots a 16 ms frame
+//   - which portfolio strategy wins on each generator's mazes
+//   - the wall follower and Trémaux on a memory-mapped bitboard file,
+//     their memory against visited grids, and Trémaux again when held to
+//     a BitGrid's worth of memory
+//   - a thread-count sweep of MazeLibraryGenerator
+//
+// A new experiment gets its own bullet here.
+
+#include "MazeFactory.hpp"
+#include "MazeSolutionFactory.hpp"
+#include "myMazeGenerator.hpp"
+#include "myEllerMazeGenerator.hpp"
+#include "myKruskalMazeGenerator.hpp"
+#include "myMazeSolver.hpp"
+#include "BitGrid.hpp"
+#include "myBFSMazeSolver.hpp"
+#include "myAStarMazeSolver.hpp"
+#include "myBidirectionalMazeSolver.hpp"
+#include "MazeTreeIndex.hpp"
+#include "MazeHierarchy.hpp"
+#include "MazeBitboard.hpp"
+#include "NeighbourMask.hpp"
+#include "MazeBatchSolver.hpp"
+#include "MazeLibraryGenerator.hpp"
+#include "myWavefrontMazeSolver.hpp"
+#include "myLPAStarMazeSolver.hpp"
+#include "myPortfolioMazeSolver.hpp"
+#include "myWallFollowerMazeSolver.hpp"
+#include "myTremauxMazeSolver.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+using namespace std;
+
+
+namespace
+{
+    // Every benchmark maze is generated from this seed, so two runs time
+    // exactly the same mazes.
+    constexpr uint64_t BENCHMARK_SEED = 46;
+
+
+    double secondsSince(chrono::steady_clock::time_point start)
+    {
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+
+    void benchmarkGenerator(int size)
+    {
+        unique_ptr<Maze> maze = MazeFactory{}.createMaze(size, size);
+        myMazeGenerator generator{myMazeGenerator::Mode::iterative};
+        generator.setSeed(BENCHMARK_SEED);
+
+        auto start = chrono::steady_clock::now();
+        generator.generateMaze(*maze);
+        double seconds = secondsSince(start);
+
+        double cells = static_cast<double>(size) * size;
+        cout << "iterative " << size << "x" << size << ": "
+             << seconds << " s, " << cells / seconds << " cells/s" << endl;
+    }
+
+
+    void benchmarkParallelGenerator(int size)
+    {
+        unique_ptr<Maze> maze = MazeFactory{}.createMaze(size, size);
+        myMazeGenerator generator{myMazeGenerator::Mode::parallel};
+        double cells = static_cast<double>(size) * size;
+        double oneThread = 0.0;
+
+        unsigned int cores = max(1u, thread::hardware_concurrency());
+        for (unsigned int threads = 1; threads <= cores; threads *= 2)
+        {
+            generator.setThreadCount(threads);
+            generator.setSeed(BENCHMARK_SEED);
+            auto start = chrono::steady_clock::now();
+            generator.generateMaze(*maze);
+            double seconds = secondsSince(start);
+            if (threads == 1)
+            {
+                oneThread = seconds;
+            }
+
+            cout << "parallel " << size << "x" << size << " " << threads << " threads: "
+                 << seconds << " s, " << cells / seconds << " cells/s, "
+                 << oneThread / seconds << "x speedup" << endl;
+        }
+    }
+
+
+    template <typename Solver>
+    void benchmarkSolver(const char* name, Solver& solver, const Maze& maze)
+    {
+        unique_ptr<MazeSolution> solution =
+            MazeSolutionFactory{}.createMazeSolution(maze.getWidth(), maze.getHeight());
+
+        auto start = chrono::steady_clock::now();
+        solver.solveMaze(maze, *solution);
+        double seconds = secondsSince(start);
+
+        cout << name << " " << maze.getWidth() << "x" << maze.getHeight() << ": "
+             << seconds << " s, " << solver.getNodesExpanded() << " cells expanded, "
+             << solution->getMovements().size() << " steps" << endl;
+    }
+
+
+    void benchmarkSolvers(int size)
+    {
+        unique_ptr<Maze> maze = MazeFactory{}.createMaze(size, size);
+        myMazeGenerator generator{myMazeGenerator::Mode::iterative};
+        generator.setSeed(BENCHMARK_SEED);
+        generator.generateMaze(*maze);
+
+        myBFSMazeSolver bfs;
+        benchmarkSolver("bfs", bfs, *maze);
+        myAStarMazeSolver astar;
+        benchmarkSolver("astar", astar, *maze);
+        myBidirectionalMazeSolver bidirectional;
+        benchmarkSolver("bidirectional", bidirectional, *maze);
+    }
+
+
+    void benchmarkTreeIndex(int size)
+    {
+        unique_ptr<Maze> maze = MazeFactory{}.createMaze(size, size);
+        myMazeGenerator generator{myMazeGenerator::Mode::iterative};
+        generator.setSeed(BENCHMARK_SEED);
+        generator.generateMaze(*maze);
+
+        MazeTreeIndex index;
+        auto start = chrono::steady_clock::now();
+        index.build(*maze);
+        double buildSeconds = secondsSince(start);
+
+        const int queries = 1000000;
+        default_random_engine engine{12345};
+        uniform_int_distribution<int> coordinate{0, size-1};
+        long long total = 0;
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < queries; i++)
+        {
+            total += index.pathLength(
+                {coordinate(engine), coordinate(engine)},
+                {coordinate(engine), coordinate(engine)});
+        }
+        double querySeconds = secondsSince(start);
+
+        cout << "tree index " << size << "x" << size << ": "
+             << buildSeconds << " s build, "
+             << querySeconds / queries * 1e9 << " ns/query, "
+             << static_cast<double>(total) / queries << " average length" << endl;
+    }
+
+
+    void benchmarkNeighbourMasks(int size)
+    {
+        unique_ptr<Maze> maze = MazeFactory{}.createMaze(size, size);
+        myMazeGenerator generator{myMazeGenerator::Mode::iterative};
+        generator.setSeed(BENCHMARK_SEED);
+        generator.generateMaze(*maze);
+        MazeBitboard bitboard = MazeBitboard::fromMaze(*maze);
+
+        auto start = chrono::steady_clock::now();
+        long long cellDeadEnds = 0;
+        for (int y = 0; y < size; y++)
+        {
+            for (int x = 0; x < size; x++)
+            {
+                cellDeadEnds += NeighbourMask::count(NeighbourMask::open(bitboard,x,y)) == 1;
+            }
+        }
+        double cellSeconds = secondsSince(start);
+
+        start = chrono::steady_clock::now();
+        vector<unsigned char> masks(size);
+        long long rowDeadEnds = 0;
+        for (int y = 0; y < size; y++)
+        {
+            NeighbourMask::openRow(bitboard,y,masks.data());
+            for (unsigned char mask : masks)
+            {
+                rowDeadEnds += NeighbourMask::count(mask) == 1;
+            }
+        }
+        double rowSeconds = secondsSince(start);
+
+        cout << "dead ends " << size << "x" << size << ": "
+             << cellDeadEnds << " per cell in " << cellSeconds << " s, "
+             << rowDeadEnds << " by row in " << rowSeconds << " s" << endl;
+    }
+
+
+    void benchmarkBatchSolver(int count, int size)
+    {
+        vector<unique_ptr<Maze>> mazes;
+        vector<unique_ptr<MazeSolution>> solutions;
+        vector<MazeBatchSolver::Job> jobs;
+        myMazeGenerator generator{myMazeGenerator::Mode::iterative};
+        generator.setSeed(BENCHMARK_SEED);
+        for (int i = 0; i < count; i++)
+        {
+            mazes.push_back(MazeFactory{}.createMaze(size, size));
+            generator.generateMaze(*mazes.back());
+            solutions.push_back(MazeSolutionFactory{}.createMazeSolution(size, size));
+            jobs.push_back({mazes.back().get(), solutions.back().get()});
+        }
+
+        unsigned int cores = max(1u, thread::hardware_concurrency());
+        for (unsigned int threads = 1; threads <= cores; threads *= 2)
+        {
+            MazeBatchSolver batch{threads};
+            batch.solveAll(jobs);
+            MazeBatchStatistics statistics = batch.getStatistics();
+            cout << "batch " << count << " x " << size << "x" << size << " " << threads << " threads: "
+                 << statistics.mazesPerSecond << " mazes/s, latency median "
+                 << statistics.medianLatency << " s, p99 " << statistics.p99Latency
+                 << " s, max " << statistics.maxLatency << " s" << endl;
+        }
+    }
+
+
+    // An empty maze is the wavefront solver's best case: nothing stops a
+    // row from being flooded end to end in one step.
+    void benchmarkWavefront(int size)
+    {
+        unique_ptr<Maze> maze = MazeFactory{}.createMaze(size, size);
+        maze->removeAllWalls();
+        MazeBitboard bitboard = MazeBitboard::fromMaze(*maze);
+        vector<Direction> path;
+
+        myBFSMazeSolver bfs;
+        auto start = chrono::steady_clock::now();
+        bfs.findPath(*maze, {0, 0}, {size-1, size-1}, path);
+        double bfsSeconds = secondsSince(start);
+
+        myWavefrontMazeSolver wavefront;
+        start = chrono::steady_clock::now();
+        wavefront.findPath(bitboard, {0, 0}, {size-1, size-1}, path);
+        double wavefrontSeconds = secondsSince(start);
+
+        cout << "open " << size << "x" << size << ": bfs " << bfsSeconds << " s, wavefront "
+             << wavefrontSeconds << " s, " << bfsSeconds / wavefrontSeconds << "x" << endl;
+
+        unique_ptr<MazeSolution> solution = MazeSolutionFactory{}.createMazeSolution(size, size);
+        start = chrono::steady_clock::now();
+        bfs.solveMaze(*maze, *solution);
+        bfsSeconds = secondsSince(start);
+
+        solution = MazeSolutionFactory{}.createMazeSolution(size, size);
+        start = chrono::steady_clock::now();
+        wavefront.solveMaze(*maze, *solution);
+        wavefrontSeconds = secondsSince(start);
+
+        cout << "open " << size << "x" << size << " through solveMaze: bfs " << bfsSeconds
+             << " s, wavefront " << wavefrontSeconds << " s, " << bfsSeconds / wavefrontSeconds
+             << "x" << endl;
+    }
+
+
+    // Opens random doors (removes interior walls) one at a time in a perfect
+    // maze, repairing the LPA* route after each and solving it again from
+    // scratch with A* for comparison.
+    void benchmarkRepair(int size, int doors)
+    {
+        unique_ptr<Maze> maze = MazeFactory{}.createMaze(size, size);
+        myMazeGenerator generator{myMazeGenerator::Mode::iterative};
+        generator.setSeed(BENCHMARK_SEED);
+        generator.generateMaze(*maze);
+        pair<int,int> start{0, 0};
+        pair<int,int> end{size-1, size-1};
+
+        myLPAStarMazeSolver lpastar;
+        lpastar.begin(*maze, start, end);
+        long long fullExpanded = lpastar.getNodesExpanded();
+
+        myAStarMazeSolver astar;
+        vector<Direction> path;
+        mt19937 engine(BENCHMARK_SEED);
+        long long repairExpanded = 0;
+        long long astarExpanded = 0;
+        double repairSeconds = 0;
+        double astarSeconds = 0;
+        for (int i = 0; i < doors; i++)
+        {
+            int x = engine() % (size-1);
+            int y = engine() % (size-1);
+            Direction direction = engine() % 2 == 0 ? Direction::right : Direction::down;
+            maze->removeWall(x, y, direction);
+
+            auto began = chrono::steady_clock::now();
+            lpastar.wallChanged(x, y, direction);
+            repairSeconds += secondsSince(began);
+            repairExpanded += lpastar.getNodesExpanded();
+
+            began = chrono::steady_clock::now();
+            astar.findPath(*maze, start, end, path);
+            astarSeconds += secondsSince(began);
+            astarExpanded += astar.getNodesExpanded();
+        }
+
+        cout << "repair " << size << "x" << size << ", " << doors << " doors: first search "
+             << fullExpanded << " expanded; per door lpa* " << repairExpanded / doors
+             << " expanded, " << repairSeconds / doors << " s; a* "
+             << astarExpanded / doors << " expanded, " << astarSeconds / doors << " s" << endl;
+    }
+
+
+    void benchmarkCounters(int size)
+    {
+        unique_ptr<Maze> maze = MazeFactory{}.createMaze(size, size);
+        vector<pair<const char*, myMazeGenerator::Mode>> modes = {
+            {"iterative", myMazeGenerator::Mode::iterative},
+            {"parallel", myMazeGenerator::Mode::parallel},
+        };
+        for (const auto& mode : modes)
+        {
+            myMazeGenerator generator{mode.second};
+            generator.setSeed(BENCHMARK_SEED);
+            generator.generateMaze(*maze);
+            cout << "counters " << mode.first << " " << size << "x" << size << ": "
+                 << generator.getCounters() << endl;
+        }
+
+        unique_ptr<MazeSolution> solution = MazeSolutionFactory{}.createMazeSolution(size, size);
+        myMazeSolver solver;
+        solver.setSeed(BENCHMARK_SEED);
+        solver.solveMaze(*maze, *solution);
+        cout << "counters solver " << size << "x" << size << ": " << solver.getCounters() << endl;
+    }
+
+
+    // The same random queries answered by breadth-first search over the
+    // whole maze and by MazeHierarchy, whose build time is shown apart.
+    void benchmarkHierarchy(int size, int queries)
+    {
+        unique_ptr<Maze> maze = MazeFactory{}.createMaze(size, size);
+        myMazeGenerator generator{myMazeGenerator::Mode::iterative};
+        generator.setSeed(BENCHMARK_SEED);
+        generator.generateMaze(*maze);
+
+        mt19937 engine(BENCHMARK_SEED);
+        vector<pair<pair<int,int>, pair<int,int>>> ends(queries);
+        for (auto& end : ends)
+        {
+            end.first = {static_cast<int>(engine() % size), static_cast<int>(engine() % size)};
+            end.second = {static_cast<int>(engine() % size), static_cast<int>(engine() % size)};
+        }
+
+        vector<Direction> path;
+        myBFSMazeSolver bfs;
+        auto start = chrono::steady_clock::now();
+        for (const auto& end : ends)
+        {
+            bfs.findPath(*maze, end.first, end.second, path);
+        }
+        double bfsSeconds = secondsSince(start);
+
+        MazeHierarchy hierarchy;
+        start = chrono::steady_clock::now();
+        hierarchy.build(*maze);
+        double buildSeconds = secondsSince(start);
+
+        start = chrono::steady_clock::now();
+        for (const auto& end : ends)
+        {
+            hierarchy.findPath(end.first, end.second, path);
+        }
+        double hierarchySeconds = secondsSince(start);
+
+        cout << "hierarchy " << size << "x" << size << ": " << hierarchy.getClusterCount()
+             << " clusters, " << hierarchy.getEntranceCount() << " entrances, build "
+             << buildSeconds << " s; per query bfs " << bfsSeconds / queries
+             << " s, hierarchy " << hierarchySeconds / queries << " s" << endl;
+    }
+
+
+    // Counts the calling thread's hardware cache misses between start() and
+    // stop().  stop() returns -1 if the counter couldn't be opened, which
+    // is common in containers and with a high perf_event_paranoid.
+    class CacheMisses
+    {
+    public:
+        CacheMisses()
+        {
+            perf_event_attr attributes{};
+            attributes.size = sizeof(attributes);
+            attributes.type = PERF_TYPE_HARDWARE;
+            attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+            attributes.disabled = 1;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            fd = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+        }
+
+        ~CacheMisses()
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+        }
+
+        CacheMisses(const CacheMisses&) = delete;
+        CacheMisses& operator=(const CacheMisses&) = delete;
+
+        void start()
+        {
+            if (fd >= 0)
+            {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+
+        long long stop()
+        {
+            long long count = -1;
+            if (fd < 0)
+            {
+                return count;
+            }
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd, &count, sizeof(count)) != sizeof(count))
+            {
+                count = -1;
+            }
+            return count;
+        }
+
+    private:
+        int fd;
+    };
+
+
+    // Generates and solves the same maze with each visited-grid layout.
+    void benchmarkLayouts(int size)
+    {
+        unique_ptr<Maze> maze = MazeFactory{}.createMaze(size, size);
+        unique_ptr<MazeSolution> solution = MazeSolutionFactory{}.createMazeSolution(size, size);
+        vector<pair<const char*, BitGrid::Layout>> layouts = {
+            {"row-major", BitGrid::Layout::rowMajor},
+            {"morton", BitGrid::Layout::morton},
+        };
+        CacheMisses misses;
+        for (const auto& layout : layouts)
+        {
+            myMazeGenerator generator{myMazeGenerator::Mode::iterative};
+            generator.setSeed(BENCHMARK_SEED);
+            generator.setGridLayout(layout.second);
+            misses.start();
+            auto start = chrono::steady_clock::now();
+            generator.generateMaze(*maze);
+            double generateSeconds = secondsSince(start);
+            long long generateMisses = misses.stop();
+
+            myMazeSolver solver{myMazeSolver::Mode::replay};
+            solver.setSeed(BENCHMARK_SEED);
+            solver.setGridLayout(layout.second);
+            misses.start();
+            start = chrono::steady_clock::now();
+            solver.solveMaze(*maze, *solution);
+            double solveSeconds = secondsSince(start);
+            long long solveMisses = misses.stop();
+
+            cout << layout.first << " " << size << "x" << size << ": generate "
+                 << generateSeconds << " s, " << generateMisses << " misses; solve "
+                 << solveSeconds << " s, " << solveMisses << " misses" << endl;
+        }
+    }
+
+
+    void benchmarkTimeSlices(int size)
+    {
+        unique_ptr<Maze> maze = MazeFactory{}.createMaze(size, size);
+        myMazeGenerator generator;
+        generator.setSeed(BENCHMARK_SEED);
+        generator.begin(*maze);
+
+        chrono::milliseconds frame{16};
+        int frames = 0;
+        double longest = 0;
+        bool finished = false;
+        while (!finished)
+        {
+            auto start = chrono::steady_clock::now();
+            finished = generator.runUntil(start + frame);
+            longest = max(longest, secondsSince(start));
+            frames++;
+        }
+
+        cout << "time slices " << size << "x" << size << ": " << frames
+             << " frames of 16 ms, longest " << longest * 1000 << " ms" << endl;
+    }
+
+
+    void benchmarkPortfolio(int size, int mazes)
+    {
+        vector<pair<const char*, function<unique_ptr<MazeGenerator>()>>> shapes = {
+            {"backtracker", []() -> unique_ptr<MazeGenerator> {
+                return make_unique<myMazeGenerator>(myMazeGenerator::Mode::iterative); }},
+            {"eller", []() -> unique_ptr<MazeGenerator> { return make_unique<myEllerMazeGenerator>(); }},
+            {"kruskal", []() -> unique_ptr<MazeGenerator> { return make_unique<myKruskalMazeGenerator>(); }},
+        };
+        unique_ptr<Maze> maze = MazeFactory{}.createMaze(size, size);
+        myPortfolioMazeSolver portfolio;
+        vector<Direction> path;
+        for (const auto& shape : shapes)
+        {
+            map<string, int> wins;
+            for (int i = 0; i < mazes; i++)
+            {
+                shape.second()->generateMaze(*maze);
+                portfolio.findPath(*maze, {0, 0}, {size-1, size-1}, path);
+                wins[portfolio.getWinner()]++;
+            }
+
+            cout << "portfolio " << shape.first << " " << size << "x" << size << ":";
+            for (const auto& win : wins)
+            {
+                cout << " " << win.first << " " << win.second;
+            }
+            cout << endl;
+        }
+    }
+
+
+    // Eller's generator streams the maze to a bitboard file, which is then
+    // mapped and solved without ever building a Maze.  Each solver's
+    // memory is printed next to what one-bit and one-byte visited grids
+    // for the same maze would take.
+    void benchmarkStreamedSolvers(int size)
+    {
+        string file = "exp-streamed.maze";
+        {
+            myEllerMazeGenerator generator;
+            generator.setSeed(BENCHMARK_SEED);
+            MazeBitboardWriter writer{file, size, size};
+            generator.generateRows(size, size, writer);
+            writer.finish();
+        }
+        MazeBitboard bitboard = MazeBitboard::map(file);
+        vector<Direction> path;
+
+        myWallFollowerMazeSolver wallFollower;
+        auto start = chrono::steady_clock::now();
+        wallFollower.findPath(bitboard, {0, 0}, {size-1, size-1}, path);
+        double wallFollowerSeconds = secondsSince(start);
+        size_t length = path.size();
+
+        myTremauxMazeSolver tremaux;
+        start = chrono::steady_clock::now();
+        tremaux.findPath(bitboard, {0, 0}, {size-1, size-1}, path);
+        double tremauxSeconds = secondsSince(start);
+
+        cout << "streamed " << size << "x" << size << ": route " << length
+             << ", wall follower " << wallFollower.getSteps() << " steps in "
+             << wallFollowerSeconds << " s, tremaux " << tremaux.getSteps()
+             << " steps and " << tremaux.getJunctionsMarked() << " junctions in "
+             << tremauxSeconds << " s" << endl;
+        size_t bitGridBytes = BitGrid{size, size}.memoryBytes();
+        cout << "streamed " << size << "x" << size << " memory: wall follower "
+             << wallFollower.getMemoryBytes() << " bytes, tremaux "
+             << tremaux.getMemoryBytes() << " bytes, BitGrid "
+             << bitGridBytes << " bytes, byte grid "
+             << static_cast<size_t>(size) * size << " bytes" << endl;
+
+        tremaux.setMemoryLimit(bitGridBytes);
+        bool found = tremaux.findPath(bitboard, {0, 0}, {size-1, size-1}, path);
+        cout << "streamed " << size << "x" << size << " tremaux within a BitGrid's memory: "
+             << (found ? "found the end" : tremaux.hitMemoryLimit() ? "ran out" : "no route")
+             << " after " << tremaux.getSteps() << " steps" << endl;
+        remove(file.c_str());
+    }
+
+
+    // Every thread count writes the same files, so the sweep only changes
+    // how fast they appear.
+    void benchmarkLibrary(int count, int size)
+    {
+        string directory = "exp-library";
+        mkdir(directory.c_str(), 0755);
+        vector<string> paths;
+        unsigned int cores = max(1u, thread::hardware_concurrency());
+        for (unsigned int threads = 1; threads <= cores; threads *= 2)
+        {
+            MazeLibraryGenerator library{threads};
+            paths = library.generate(count, size, size, BENCHMARK_SEED, directory);
+            MazeLibraryStatistics statistics = library.getStatistics();
+            cout << "library " << count << " x " << size << "x" << size << " " << threads << " threads: "
+                 << statistics.mazesPerSecond << " mazes/s, "
+                 << statistics.cellsPerSecond << " cells/s" << endl;
+        }
+        for (const string& path : paths)
+        {
+            remove(path.c_str());
+        }
+        rmdir(directory.c_str());
+    }
+
+
+    // Both grids are probed the way the generator probes them: every cell
+    // checks its four neighbours and then marks itself visited.
+    template <typename Test, typename Set>
+    double probeGrid(int size, Test test, Set set)
+    {
+        auto start = chrono::steady_clock::now();
+        long long unvisited = 0;
+        for (int y = 0; y < size; y++)
+        {
+            for (int x = 0; x < size; x++)
+            {
+                unvisited += (x > 0 && !test(x-1,y)) + (x+1 < size && !test(x+1,y))
+                           + (y > 0 && !test(x,y-1)) + (y+1 < size && !test(x,y+1));
+                set(x,y);
+            }
+        }
+        double seconds = secondsSince(start);
+        if (unvisited < 0)
+        {
+            cout << unvisited << endl;
+        }
+        return seconds;
+    }
+
+
+    void benchmarkVisitedGrids(int size)
+    {
+        auto start = chrono::steady_clock::now();
+        vector<vector<bool>> nested(size, vector<bool>(size, false));
+        double nestedAllocate = secondsSince(start);
+        double nestedProbe = probeGrid(size,
+            [&](int x, int y) { return nested[x][y]; },
+            [&](int x, int y) { nested[x][y] = true; });
+        size_t nestedBytes = sizeof(vector<bool>) * nested.capacity()
+            + static_cast<size_t>(size) * ((size + 63) / 64) * sizeof(uint64_t);
+
+        start = chrono::steady_clock::now();
+        BitGrid flat{size, size};
+        double flatAllocate = secondsSince(start);
+        double flatProbe = probeGrid(size,
+            [&](int x, int y) { return flat.test(x,y); },
+            [&](int x, int y) { flat.set(x,y); });
+
+        start = chrono::steady_clock::now();
+        flat.reset();
+        double flatReset = secondsSince(start);
+
+        cout << "visited " << size << "x" << size << ": "
+             << "vector<vector<bool>> " << nestedBytes << " bytes, "
+             << nestedAllocate << " s alloc, " << nestedProbe << " s probe; "
+             << "BitGrid " << flat.memoryBytes() << " bytes, "
+             << flatAllocate << " s alloc, " << flatProbe << " s probe, "
+             << flatReset << " s reset" << endl;
+    }
+
+
+    // The suite.
+
+    struct GeneratorEntry
+    {
+        string name;
+        function<unique_ptr<MazeGenerator>(uint64_t seed)> make;
+    };
+
+
+    struct SolverEntry
+    {
+        string name;
+        function<unique_ptr<MazeSolver>()> make;
+    };
+
+
+    template <typename Generator>
+    unique_ptr<MazeGenerator> seeded(unique_ptr<Generator> generator, uint64_t seed)
+    {
+        generator->setSeed(seed);
+        return generator;
+    }
+
+
+    // Keep these in step with the ICS46_DYNAMIC_FACTORY_REGISTER lines;
+    // myMazeGenerator's modes are listed one by one.
+    vector<GeneratorEntry> generators()
+    {
+        return {
+            {"recursive", [](uint64_t seed) {
+                return seeded(make_unique<myMazeGenerator>(myMazeGenerator::Mode::recursive), seed); }},
+            {"iterative", [](uint64_t seed) {
+                return seeded(make_unique<myMazeGenerator>(myMazeGenerator::Mode::iterative), seed); }},
+            {"parallel", [](uint64_t seed) {
+                return seeded(make_unique<myMazeGenerator>(myMazeGenerator::Mode::parallel), seed); }},
+            {"eller", [](uint64_t seed) {
+                return seeded(make_unique<myEllerMazeGenerator>(), seed); }},
+            {"kruskal", [](uint64_t seed) {
+                return seeded(make_unique<myKruskalMazeGenerator>(), seed); }},
+        };
+    }
+
+
+    vector<SolverEntry> solvers()
+    {
+        return {
+            {"dfs", []() -> unique_ptr<MazeSolver> {
+                auto solver = make_unique<myMazeSolver>();
+                solver->setSeed(BENCHMARK_SEED);
+                return solver; }},
+            {"dfs-replay", []() -> unique_ptr<MazeSolver> {
+                auto solver = make_unique<myMazeSolver>(myMazeSolver::Mode::replay);
+                solver->setSeed(BENCHMARK_SEED);
+                return solver; }},
+            {"bfs", []() -> unique_ptr<MazeSolver> { return make_unique<myBFSMazeSolver>(); }},
+            {"astar", []() -> unique_ptr<MazeSolver> { return make_unique<myAStarMazeSolver>(); }},
+            {"bidirectional", []() -> unique_ptr<MazeSolver> { return make_unique<myBidirectionalMazeSolver>(); }},
+            {"wavefront", []() -> unique_ptr<MazeSolver> { return make_unique<myWavefrontMazeSolver>(); }},
+            {"lpastar", []() -> unique_ptr<MazeSolver> { return make_unique<myLPAStarMazeSolver>(); }},
+            {"portfolio", []() -> unique_ptr<MazeSolver> { return make_unique<myPortfolioMazeSolver>(); }},
+            {"wallfollower", []() -> unique_ptr<MazeSolver> { return make_unique<myWallFollowerMazeSolver>(); }},
+            {"tremaux", []() -> unique_ptr<MazeSolver> { return make_unique<myTremauxMazeSolver>(); }},
+        };
+    }
+
+
+    struct Result
+    {
+        string kind;
+        string name;
+        int size = 0;
+        uint64_t seed = 0;
+        string status = "ok";
+        double seconds = 0.0;
+        double cellsPerSecond = 0.0;
+        long peakRssKb = 0;
+        long long pathLength = -1;
+    };
+
+
+    const char* CSV_HEADER = "kind,name,width,height,seed,status,seconds,cells_per_sec,peak_rss_kb,path_length";
+
+
+    string toCsv(const Result& result)
+    {
+        ostringstream out;
+        out << result.kind << "," << result.name << "," << result.size << "," << result.size << ","
+            << result.seed << "," << result.status << "," << result.seconds << ","
+            << result.cellsPerSecond << "," << result.peakRssKb << "," << result.pathLength;
+        return out.str();
+    }
+
+
+    bool fromCsv(const string& line, Result& result)
+    {
+        vector<string> fields;
+        string field;
+        istringstream in{line};
+        while (getline(in, field, ','))
+        {
+            fields.push_back(field);
+        }
+        if (fields.size() != 10 || fields[0] == "kind")
+        {
+            return false;
+        }
+        result.kind = fields[0];
+        result.name = fields[1];
+        result.size = stoi(fields[2]);
+        result.seed = stoull(fields[4]);
+        result.status = fields[5];
+        result.seconds = stod(fields[6]);
+        result.cellsPerSecond = stod(fields[7]);
+        result.peakRssKb = stol(fields[8]);
+        result.pathLength = stoll(fields[9]);
+        return true;
+    }
+
+
+    long peakRssKb()
+    {
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;
+    }
+
+
+    Result runGenerator(const GeneratorEntry& entry, int size, uint64_t seed)
+    {
+        Result result{"generate", entry.name, size, seed};
+        unique_ptr<Maze> maze = MazeFactory{}.createMaze(size, size);
+        unique_ptr<MazeGenerator> generator = entry.make(seed);
+
+        auto start = chrono::steady_clock::now();
+        generator->generateMaze(*maze);
+        result.seconds = secondsSince(start);
+        return result;
+    }
+
+
+    Result runSolver(const SolverEntry& entry, int size, uint64_t seed)
+    {
+        Result result{"solve", entry.name, size, seed};
+        unique_ptr<Maze> maze = MazeFactory{}.createMaze(size, size);
+        myMazeGenerator generator{myMazeGenerator::Mode::iterative};
+        generator.setSeed(seed);
+        generator.generateMaze(*maze);
+
+        unique_ptr<MazeSolution> solution = MazeSolutionFactory{}.createMazeSolution(size, size);
+        unique_ptr<MazeSolver> solver = entry.make();
+
+        auto start = chrono::steady_clock::now();
+        solver->solveMaze(*maze, *solution);
+        result.seconds = secondsSince(start);
+        result.pathLength = solution->getMovements().size();
+        if (!solution->isComplete())
+        {
+            result.status = "unsolved";
+        }
+        return result;
+    }
+
+
+    // Runs one case in a forked child, keeping the fastest of repeat tries.
+    // The child sends its CSV line back through a pipe.
+    Result isolated(Result failed, int repeat, function<Result()> run)
+    {
+        int channel[2];
+        if (pipe(channel) != 0)
+        {
+            failed.status = "nopipe";
+            return failed;
+        }
+
+        pid_t child = fork();
+        if (child == 0)
+        {
+            close(channel[0]);
+            Result best = run();
+            for (int i = 1; i < repeat; i++)
+            {
+                Result again = run();
+                if (again.seconds < best.seconds)
+                {
+                    best = again;
+                }
+            }
+            double cells = static_cast<double>(best.size) * best.size;
+            best.cellsPerSecond = best.seconds > 0.0 ? cells / best.seconds : 0.0;
+            best.peakRssKb = peakRssKb();
+            string line = toCsv(best) + "\n";
+            ssize_t written = write(channel[1], line.data(), line.size());
+            _exit(written == static_cast<ssize_t>(line.size()) ? 0 : 1);
+        }
+
+        close(channel[1]);
+        string line;
+        char buffer[512];
+        ssize_t count;
+        while ((count = read(channel[0], buffer, sizeof(buffer))) > 0)
+        {
+            line.append(buffer, count);
+        }
+        close(channel[0]);
+        int status = 0;
+        waitpid(child, &status, 0);
+
+        Result result;
+        if (child < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0 || !fromCsv(line, result))
+        {
+            failed.status = "crashed";
+            return failed;
+        }
+        return result;
+    }
+
+
+    vector<long long> parseList(const string& text)
+    {
+        vector<long long> values;
+        string item;
+        istringstream in{text};
+        while (getline(in, item, ','))
+        {
+            values.push_back(stoll(item));
+        }
+        return values;
+    }
+
+
+    int runSuite(const vector<long long>& sizes, const vector<long long>& seeds, int repeat, ostream& out)
+    {
+        out << CSV_HEADER << endl;
+        auto report = [&](const Result& result)
+        {
+            out << toCsv(result) << endl;
+            cerr << result.kind << " " << result.name << " " << result.size << "x" << result.size
+                 << " seed " << result.seed << ": " << result.status << ", "
+                 << result.cellsPerSecond << " cells/s, " << result.peakRssKb << " KB peak" << endl;
+        };
+
+        for (long long size : sizes)
+        {
+            for (long long seed : seeds)
+            {
+                for (const GeneratorEntry& entry : generators())
+                {
+                    report(isolated({"generate", entry.name, static_cast<int>(size), static_cast<uint64_t>(seed)},
+                        repeat, [&]() { return runGenerator(entry, size, seed); }));
+                }
+                for (const SolverEntry& entry : solvers())
+                {
+                    report(isolated({"solve", entry.name, static_cast<int>(size), static_cast<uint64_t>(seed)},
+                        repeat, [&]() { return runSolver(entry, size, seed); }));
+                }
+            }
+        }
+        return 0;
+    }
+
+
+    map<tuple<string,string,int,uint64_t>, Result> readResults(const string& path)
+    {
+        map<tuple<string,string,int,uint64_t>, Result> results;
+        ifstream in{path};
+        string line;
+        while (getline(in, line))
+        {
+            Result result;
+            if (fromCsv(line, result))
+            {
+                results[make_tuple(result.kind, result.name, result.size, result.seed)] = result;
+            }
+        }
+        return results;
+    }
+
+
+    int compareResults(const string& beforePath, const string& afterPath, double threshold)
+    {
+        auto before = readResults(beforePath);
+        auto after = readResults(afterPath);
+        int regressions = 0;
+
+        cout << "kind,name,width,height,seed,throughput_ratio,rss_ratio,verdict" << endl;
+        for (const auto& entry : after)
+        {
+            auto match = before.find(entry.first);
+            if (match == before.end())
+            {
+                continue;
+            }
+            const Result& old = match->second;
+            const Result& now = entry.second;
+
+            string verdict = "same";
+            double speed = 0.0;
+            double memory = 0.0;
+            if (old.status != "ok" || now.status != "ok")
+            {
+                verdict = old.status == now.status ? "same" : old.status + "->" + now.status;
+                regressions += old.status == "ok";
+            }
+            else
+            {
+                speed = now.cellsPerSecond / old.cellsPerSecond;
+                memory = old.peakRssKb > 0 ? static_cast<double>(now.peakRssKb) / old.peakRssKb : 0.0;
+                if (speed < 1.0 - threshold)
+                {
+                    verdict = "slower";
+                    regressions++;
+                }
+                else if (speed > 1.0 + threshold)
+                {
+                    verdict = "faster";
+                }
+            }
+            cout << now.kind << "," << now.name << "," << now.size << "," << now.size << ","
+                 << now.seed << "," << speed << "," << memory << "," << verdict << endl;
+        }
+
+        cerr << regressions << " regression(s) beyond " << threshold * 100 << "%" << endl;
+        return regressions > 0 ? 1 : 0;
+    }
+
+
+    void runMicroBenchmarks()
+    {
+        vector<int> sizes = {1000, 4000, 10000};
+        for (int size : sizes)
+        {
+            benchmarkGenerator(size);
+        }
+
+        for (int size : sizes)
+        {
+            benchmarkVisitedGrids(size);
+        }
+
+        benchmarkParallelGenerator(4000);
+
+        for (int size : sizes)
+        {
+            benchmarkSolvers(size);
+        }
+
+        benchmarkTreeIndex(1000);
+        benchmarkNeighbourMasks(4000);
+        benchmarkBatchSolver(1000, 100);
+        benchmarkWavefront(4000);
+        benchmarkRepair(1000, 100);
+        benchmarkCounters(1000);
+        benchmarkHierarchy(1000, 100);
+
+        for (int size : sizes)
+        {
+            benchmarkLayouts(size);
+        }
+
+        benchmarkTimeSlices(4000);
+        benchmarkPortfolio(1000, 20);
+        benchmarkStreamedSolvers(10000);
+        benchmarkLibrary(1000, 200);
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    vector<long long> sizes = {100, 1000, 4000};
+    vector<long long> seeds = {1, 2, 3};
+    int repeat = 1;
+    double threshold = 0.05;
+    string outPath;
+    string comparePaths[2];
+    bool micro = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        bool hasValue = i+1 < argc;
+        if (arg == "--sizes" && hasValue)
+        {
+            sizes = parseList(argv[++i]);
+        }
+        else if (arg == "--seeds" && hasValue)
+        {
+            seeds = parseList(argv[++i]);
+        }
+        else if (arg == "--repeat" && hasValue)
+        {
+            repeat = max(1, atoi(argv[++i]));
+        }
+        else if (arg == "--out" && hasValue)
+        {
+            outPath = argv[++i];
+        }
+        else if (arg == "--threshold" && hasValue)
+        {
+            threshold = atof(argv[++i]);
+        }
+        else if (arg == "--compare" && i+2 < argc)
+        {
+            comparePaths[0] = argv[++i];
+            comparePaths[1] = argv[++i];
+        }
+        else if (arg == "--micro")
+        {
+            micro = true;
+        }
+        else
+        {
+            cerr << "unknown argument " << arg << endl;
+            return 2;
+        }
+    }
+
+    if (micro)
+    {
+        runMicroBenchmarks();
+        return 0;
+    }
+    if (!comparePaths[0].empty())
+    {
+        return compareResults(comparePaths[0], comparePaths[1], threshold);
+    }
+    if (!outPath.empty())
+    {
+        ofstream out{outPath};
+        return runSuite(sizes, seeds, repeat, out);
+    }
+    return runSuite(sizes, seeds, repeat, cout);
+}
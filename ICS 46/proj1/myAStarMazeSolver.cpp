@@ -0,0 +1,123 @@
+#include "myAStarMazeSolver.hpp"
+#include "MazeSearch.hpp"
+#include <ics46/factory/DynamicFactory.hpp>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+using namespace std;
+
+ICS46_DYNAMIC_FACTORY_REGISTER(MazeSolver, myAStarMazeSolver, "Richard's A* MazeSolver (shortest path)");
+
+namespace
+{
+    // Lowest estimate first; among equal estimates prefer the cell that is
+    // further along, which keeps the search heading down one corridor.
+    struct LaterInOrder
+    {
+        template <typename OpenCell>
+        bool operator()(const OpenCell& a, const OpenCell& b) const
+        {
+            if (a.estimate != b.estimate)
+            {
+                return a.estimate > b.estimate;
+            }
+            return a.cost < b.cost;
+        }
+    };
+}
+
+void myAStarMazeSolver::solveMaze(const Maze& maze, MazeSolution& mazeSolution)
+{
+    if (findPath(maze,mazeSolution.getStartingCell(),mazeSolution.getEndingCell(),path))
+    {
+        MazeSearch::writePath(path,mazeSolution);
+    }
+}
+
+void myAStarMazeSolver::push(OpenCell openCell)
+{
+    open.push_back(openCell);
+    push_heap(open.begin(), open.end(), LaterInOrder{});
+}
+
+myAStarMazeSolver::OpenCell myAStarMazeSolver::pop()
+{
+    pop_heap(open.begin(), open.end(), LaterInOrder{});
+    OpenCell openCell = open.back();
+    open.pop_back();
+    return openCell;
+}
+
+bool myAStarMazeSolver::findPath(const Maze& maze,pair<int,int> start,pair<int,int> end,vector<Direction>& path)
+{
+    int width = maze.getWidth();
+    size_t cells = static_cast<size_t>(width) * maze.getHeight();
+    closed.resize(width, maze.getHeight());
+    cost.assign(cells, INT_MAX);
+    cameFrom.resize(cells);
+    open.clear();
+    nodesExpanded = 0;
+
+    auto heuristic = [&](int x, int y)
+    {
+        return abs(x - end.first) + abs(y - end.second);
+    };
+
+    size_t first = MazeSearch::cellIndex(start.first,start.second,width);
+    cost[first] = 0;
+    push({heuristic(start.first,start.second), 0, static_cast<int>(first)});
+    int target = static_cast<int>(MazeSearch::cellIndex(end.first,end.second,width));
+
+    while (open.size() > 0)
+    {
+        OpenCell current = pop();
+        int x = current.cell % width;
+        int y = current.cell / width;
+        // A cell can be queued more than once; only its cheapest entry
+        // counts.
+        if (closed.testAndSet(x,y))
+        {
+            continue;
+        }
+        nodesExpanded++;
+        if (nodesExpanded % MazeSearch::CANCEL_POLL_INTERVAL == 0 && MazeSearch::cancelled(cancel))
+        {
+            return false;
+        }
+        if (current.cell == target)
+        {
+            MazeSearch::tracePath(cameFrom,width,start,end,path);
+            return true;
+        }
+
+        for (Direction direction : MazeSearch::directions)
+        {
+            if (!MazeSearch::canMove(maze,x,y,direction))
+            {
+                continue;
+            }
+            int xc = x;
+            int yc = y;
+            MazeSearch::step(direction,xc,yc);
+            size_t next = MazeSearch::cellIndex(xc,yc,width);
+            int nextCost = current.cost + 1;
+            if (!closed.test(xc,yc) && nextCost < cost[next])
+            {
+                cost[next] = nextCost;
+                cameFrom[next] = static_cast<unsigned char>(direction);
+                push({nextCost + heuristic(xc,yc), nextCost, static_cast<int>(next)});
+            }
+        }
+    }
+    return false;
+}
+
+long long myAStarMazeSolver::getNodesExpanded() const
+{
+    return nodesExpanded;
+}
+
+void myAStarMazeSolver::setCancel(const atomic<bool>* cancel)
+{
+    this->cancel = cancel;
+}
@@ -0,0 +1,49 @@
+#ifndef MYASTARMAZESOLVER_HPP
+#define MYASTARMAZESOLVER_HPP
+
+#include "MazeSolver.hpp"
+#include "MazeSolution.hpp"
+#include "Direction.hpp"
+#include "Maze.hpp"
+#include "BitGrid.hpp"
+#include <atomic>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// A* search guided by the Manhattan distance to the ending cell.  Every
+// move costs one, so the heuristic never overestimates and the route is a
+// shortest one, usually after expanding fewer cells than breadth-first.
+class myAStarMazeSolver: public MazeSolver
+{
+public:
+    void solveMaze(const Maze& maze, MazeSolution& mazeSolution) override;
+    bool findPath(const Maze& maze,pair<int,int> start,pair<int,int> end,vector<Direction>& path);
+    long long getNodesExpanded() const;
+
+    // setCancel() makes findPath() give up and return false once *cancel
+    // turns true; pass nullptr to stop watching.
+    void setCancel(const atomic<bool>* cancel);
+
+private:
+    struct OpenCell
+    {
+        int estimate;
+        int cost;
+        int cell;
+    };
+
+    void push(OpenCell openCell);
+    OpenCell pop();
+
+private:
+    BitGrid closed;
+    vector<int> cost;
+    vector<unsigned char> cameFrom;
+    vector<OpenCell> open;
+    vector<Direction> path;
+    long long nodesExpanded = 0;
+    const atomic<bool>* cancel = nullptr;
+};
+
+#endif
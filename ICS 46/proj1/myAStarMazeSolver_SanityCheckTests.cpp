@@ -0,0 +1,81 @@
+// myAStarMazeSolver_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks that A* finds the same shortest routes breadth-first search does
+// while expanding fewer cells to get there.
+
+#include <gtest/gtest.h>
+#include "myAStarMazeSolver.hpp"
+#include "myBFSMazeSolver.hpp"
+#include "MazeSolutionFactory.hpp"
+#include "MazeSanityChecks.hpp"
+#include <atomic>
+#include <vector>
+
+using namespace MazeSanityChecks;
+
+
+TEST(myAStarMazeSolver_SanityCheckTests, solvesPerfectMazes)
+{
+    myAStarMazeSolver solver;
+    for (uint64_t seed : {5, 6})
+    {
+        std::unique_ptr<Maze> maze = perfectMaze(seed);
+        std::unique_ptr<MazeSolution> solution = MazeSolutionFactory{}.createMazeSolution(WIDTH, HEIGHT);
+        solver.solveMaze(*maze, *solution);
+        EXPECT_TRUE(solvedCorrectly(*maze, *solution)) << "seed " << seed;
+    }
+}
+
+
+TEST(myAStarMazeSolver_SanityCheckTests, findsTheShortestRouteThroughLoops)
+{
+    std::unique_ptr<Maze> maze = bandedMaze();
+    std::pair<int,int> start{0, 0};
+    std::pair<int,int> end{WIDTH-1, HEIGHT-1};
+    std::vector<Direction> path;
+    EXPECT_TRUE(myAStarMazeSolver{}.findPath(*maze, start, end, path));
+    EXPECT_TRUE(isRoute(*maze, start, end, path));
+    EXPECT_EQ(static_cast<size_t>(WIDTH + HEIGHT - 2), path.size());
+}
+
+
+TEST(myAStarMazeSolver_SanityCheckTests, reportsAnUnreachableEnd)
+{
+    std::unique_ptr<Maze> maze = MazeFactory{}.createMaze(4, 4);
+    maze->addAllWalls();
+    std::vector<Direction> path;
+    EXPECT_FALSE(myAStarMazeSolver{}.findPath(*maze, {0, 0}, {3, 3}, path));
+}
+
+
+TEST(myAStarMazeSolver_SanityCheckTests, givesUpWhenCancelled)
+{
+    // Cancellation is only polled every so many cells, so the maze has to
+    // be big enough for the search to get that far.
+    myMazeGenerator generator;
+    std::unique_ptr<Maze> maze = generated(generator, 200, 200);
+    std::atomic<bool> cancel{true};
+    myAStarMazeSolver solver;
+    solver.setCancel(&cancel);
+    std::vector<Direction> path;
+    EXPECT_FALSE(solver.findPath(*maze, {0, 0}, {199, 199}, path));
+
+    solver.setCancel(nullptr);
+    EXPECT_TRUE(solver.findPath(*maze, {0, 0}, {199, 199}, path));
+}
+
+
+TEST(myAStarMazeSolver_SanityCheckTests, expandsFewerCellsThanBreadthFirst)
+{
+    std::unique_ptr<Maze> maze = MazeFactory{}.createMaze(WIDTH, HEIGHT);
+    maze->removeAllWalls();
+    std::vector<Direction> path;
+    myBFSMazeSolver bfs;
+    myAStarMazeSolver astar;
+    ASSERT_TRUE(bfs.findPath(*maze, {0, 0}, {WIDTH/2, HEIGHT/2}, path));
+    ASSERT_TRUE(astar.findPath(*maze, {0, 0}, {WIDTH/2, HEIGHT/2}, path));
+    EXPECT_LT(astar.getNodesExpanded(), bfs.getNodesExpanded());
+}
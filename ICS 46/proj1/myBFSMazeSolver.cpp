@@ -0,0 +1,157 @@
+#include "myBFSMazeSolver.hpp"
+#include "MazeSearch.hpp"
+#include <ics46/factory/DynamicFactory.hpp>
+using namespace std;
+
+ICS46_DYNAMIC_FACTORY_REGISTER(MazeSolver, myBFSMazeSolver, "Richard's BFS MazeSolver (shortest path)");
+
+void myBFSMazeSolver::solveMaze(const Maze& maze, MazeSolution& mazeSolution)
+{
+    if (findPath(maze,mazeSolution.getStartingCell(),mazeSolution.getEndingCell(),path))
+    {
+        MazeSearch::writePath(path,mazeSolution);
+    }
+}
+
+bool myBFSMazeSolver::findPath(const Maze& maze,pair<int,int> start,pair<int,int> end,vector<Direction>& path)
+{
+    return findPath(maze,start,end,wholeOf(maze),path);
+}
+
+// Cells are numbered and marked relative to the window, so a search in a
+// small window only touches that many cells' worth of scratch space.
+bool myBFSMazeSolver::findPath(const Maze& maze,pair<int,int> start,pair<int,int> end,const Window& window,vector<Direction>& path)
+{
+    int width = window.width;
+    visit.resize(width, window.height);
+    cameFrom.resize(static_cast<size_t>(width) * window.height);
+    queue.clear();
+    nodesExpanded = 0;
+
+    pair<int,int> from{start.first - window.left, start.second - window.top};
+    pair<int,int> to{end.first - window.left, end.second - window.top};
+    visit.set(from.first,from.second);
+    queue.push_back(static_cast<int>(MazeSearch::cellIndex(from.first,from.second,width)));
+    int target = to.first < 0 || to.second < 0 || to.first >= width || to.second >= window.height
+        ? -1 : static_cast<int>(MazeSearch::cellIndex(to.first,to.second,width));
+
+    // queue only ever grows, so head walks it like a FIFO without popping.
+    for (size_t head = 0; head < queue.size(); head++)
+    {
+        if (head % MazeSearch::CANCEL_POLL_INTERVAL == 0 && MazeSearch::cancelled(cancel))
+        {
+            return false;
+        }
+        int cell = queue[head];
+        nodesExpanded++;
+        if (cell == target)
+        {
+            MazeSearch::tracePath(cameFrom,width,from,to,path);
+            return true;
+        }
+
+        int x = cell % width;
+        int y = cell / width;
+        for (Direction direction : MazeSearch::directions)
+        {
+            if (!canMove(maze,window,x,y,direction))
+            {
+                continue;
+            }
+            int xc = x;
+            int yc = y;
+            MazeSearch::step(direction,xc,yc);
+            if (!visit.testAndSet(xc,yc))
+            {
+                size_t next = MazeSearch::cellIndex(xc,yc,width);
+                cameFrom[next] = static_cast<unsigned char>(direction);
+                queue.push_back(static_cast<int>(next));
+            }
+        }
+    }
+    return false;
+}
+
+void myBFSMazeSolver::distanceField(const Maze& maze,pair<int,int> start,vector<uint32_t>& distance)
+{
+    distanceField(maze,vector<pair<int,int>>{start},wholeOf(maze),distance);
+}
+
+void myBFSMazeSolver::distanceField(const Maze& maze,const vector<pair<int,int>>& sources,vector<uint32_t>& distance)
+{
+    distanceField(maze,sources,wholeOf(maze),distance);
+}
+
+void myBFSMazeSolver::distanceField(const Maze& maze,pair<int,int> start,const Window& window,vector<uint32_t>& distance)
+{
+    distanceField(maze,vector<pair<int,int>>{start},window,distance);
+}
+
+// The same queue as findPath(), seeded with every source at distance zero.
+// Breadth-first order means each cell is first reached from its nearest
+// source, and distance[] itself marks which cells have been reached.
+void myBFSMazeSolver::distanceField(const Maze& maze,const vector<pair<int,int>>& sources,const Window& window,vector<uint32_t>& distance)
+{
+    int width = window.width;
+    distance.assign(static_cast<size_t>(width) * window.height, UNREACHABLE);
+    queue.clear();
+    nodesExpanded = 0;
+
+    for (const pair<int,int>& source : sources)
+    {
+        size_t cell = MazeSearch::cellIndex(source.first - window.left,source.second - window.top,width);
+        if (distance[cell] == UNREACHABLE)
+        {
+            distance[cell] = 0;
+            queue.push_back(static_cast<int>(cell));
+        }
+    }
+
+    for (size_t head = 0; head < queue.size(); head++)
+    {
+        int cell = queue[head];
+        nodesExpanded++;
+        int x = cell % width;
+        int y = cell / width;
+        for (Direction direction : MazeSearch::directions)
+        {
+            if (!canMove(maze,window,x,y,direction))
+            {
+                continue;
+            }
+            int xc = x;
+            int yc = y;
+            MazeSearch::step(direction,xc,yc);
+            size_t next = MazeSearch::cellIndex(xc,yc,width);
+            if (distance[next] == UNREACHABLE)
+            {
+                distance[next] = distance[cell] + 1;
+                queue.push_back(static_cast<int>(next));
+            }
+        }
+    }
+}
+
+myBFSMazeSolver::Window myBFSMazeSolver::wholeOf(const Maze& maze)
+{
+    return Window{0, 0, maze.getWidth(), maze.getHeight()};
+}
+
+bool myBFSMazeSolver::canMove(const Maze& maze,const Window& window,int x,int y,Direction direction)
+{
+    int xc = x;
+    int yc = y;
+    MazeSearch::step(direction,xc,yc);
+    return xc >= 0 && yc >= 0 && xc < window.width && yc < window.height
+        && !maze.wallExists(window.left + x,window.top + y,direction);
+}
+
+long long myBFSMazeSolver::getNodesExpanded() const
+{
+    return nodesExpanded;
+}
+
+void myBFSMazeSolver::setCancel(const atomic<bool>* cancel)
+{
+    this->cancel = cancel;
+}
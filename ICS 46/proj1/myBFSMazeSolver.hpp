@@ -0,0 +1,80 @@
+#ifndef MYBFSMAZESOLVER_HPP
+#define MYBFSMAZESOLVER_HPP
+
+#include "MazeSolver.hpp"
+#include "MazeSolution.hpp"
+#include "Direction.hpp"
+#include "Maze.hpp"
+#include "BitGrid.hpp"
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// Breadth-first search from the starting cell, so the route written into
+// the MazeSolution is always a shortest one.
+class myBFSMazeSolver: public MazeSolver
+{
+public:
+    void solveMaze(const Maze& maze, MazeSolution& mazeSolution) override;
+
+    // A Window is the rectangle of cells [left, left + width) across and
+    // [top, top + height) down.  It has to lie inside the maze.
+    struct Window
+    {
+        int left;
+        int top;
+        int width;
+        int height;
+    };
+
+    // findPath() leaves the shortest route from start to end in path and
+    // returns false if end can't be reached.
+    bool findPath(const Maze& maze,pair<int,int> start,pair<int,int> end,vector<Direction>& path);
+
+    // The windowed version never leaves window, which has to hold start;
+    // it returns false if end is outside it or only reachable through
+    // cells that are.
+    bool findPath(const Maze& maze,pair<int,int> start,pair<int,int> end,const Window& window,vector<Direction>& path);
+
+    // Number of cells taken off the queue by the last search.
+    long long getNodesExpanded() const;
+
+    // setCancel() makes findPath() give up and return false once *cancel
+    // turns true; pass nullptr to stop watching.
+    void setCancel(const atomic<bool>* cancel);
+
+    static constexpr uint32_t UNREACHABLE = UINT32_MAX;
+
+    // distanceField() fills distance (row-major, width * height entries)
+    // with the number of moves from start to every cell, or UNREACHABLE.
+    void distanceField(const Maze& maze,pair<int,int> start,vector<uint32_t>& distance);
+
+    // The multi-source version measures every cell against its nearest
+    // source, all in the same single pass.
+    void distanceField(const Maze& maze,const vector<pair<int,int>>& sources,vector<uint32_t>& distance);
+
+    // The windowed versions measure routes that stay inside window, which
+    // has to hold the sources.  distance then has window.width *
+    // window.height entries, row-major from the window's top-left cell.
+    void distanceField(const Maze& maze,pair<int,int> start,const Window& window,vector<uint32_t>& distance);
+    void distanceField(const Maze& maze,const vector<pair<int,int>>& sources,const Window& window,vector<uint32_t>& distance);
+
+private:
+    static Window wholeOf(const Maze& maze);
+
+    // Whether the move from (x, y), relative to window, stays inside it
+    // and isn't walled off.
+    static bool canMove(const Maze& maze,const Window& window,int x,int y,Direction direction);
+
+private:
+    BitGrid visit;
+    vector<unsigned char> cameFrom;
+    vector<int> queue;
+    vector<Direction> path;
+    long long nodesExpanded = 0;
+    const atomic<bool>* cancel = nullptr;
+};
+
+#endif
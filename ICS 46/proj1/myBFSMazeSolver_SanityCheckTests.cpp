@@ -0,0 +1,150 @@
+// myBFSMazeSolver_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks that the breadth-first solver finds shortest routes, and says so
+// when there is none.
+
+#include <gtest/gtest.h>
+#include "myBFSMazeSolver.hpp"
+#include "MazeSolutionFactory.hpp"
+#include "MazeSanityChecks.hpp"
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+using namespace MazeSanityChecks;
+
+
+TEST(myBFSMazeSolver_SanityCheckTests, solvesPerfectMazes)
+{
+    myBFSMazeSolver solver;
+    for (uint64_t seed : {5, 6})
+    {
+        std::unique_ptr<Maze> maze = perfectMaze(seed);
+        std::unique_ptr<MazeSolution> solution = MazeSolutionFactory{}.createMazeSolution(WIDTH, HEIGHT);
+        solver.solveMaze(*maze, *solution);
+        EXPECT_TRUE(solvedCorrectly(*maze, *solution)) << "seed " << seed;
+    }
+}
+
+
+TEST(myBFSMazeSolver_SanityCheckTests, findsTheShortestRouteThroughLoops)
+{
+    std::unique_ptr<Maze> maze = bandedMaze();
+    std::pair<int,int> start{0, 0};
+    std::pair<int,int> end{WIDTH-1, HEIGHT-1};
+    std::vector<Direction> path;
+    EXPECT_TRUE(myBFSMazeSolver{}.findPath(*maze, start, end, path));
+    EXPECT_TRUE(isRoute(*maze, start, end, path));
+    EXPECT_EQ(static_cast<size_t>(WIDTH + HEIGHT - 2), path.size());
+}
+
+
+TEST(myBFSMazeSolver_SanityCheckTests, reportsAnUnreachableEnd)
+{
+    std::unique_ptr<Maze> maze = MazeFactory{}.createMaze(4, 4);
+    maze->addAllWalls();
+    std::vector<Direction> path;
+    EXPECT_FALSE(myBFSMazeSolver{}.findPath(*maze, {0, 0}, {3, 3}, path));
+}
+
+
+TEST(myBFSMazeSolver_SanityCheckTests, givesUpWhenCancelled)
+{
+    // Cancellation is only polled every so many cells, so the maze has to
+    // be big enough for the search to get that far.
+    myMazeGenerator generator;
+    std::unique_ptr<Maze> maze = generated(generator, 200, 200);
+    std::atomic<bool> cancel{true};
+    myBFSMazeSolver solver;
+    solver.setCancel(&cancel);
+    std::vector<Direction> path;
+    EXPECT_FALSE(solver.findPath(*maze, {0, 0}, {199, 199}, path));
+
+    solver.setCancel(nullptr);
+    EXPECT_TRUE(solver.findPath(*maze, {0, 0}, {199, 199}, path));
+}
+
+
+TEST(myBFSMazeSolver_SanityCheckTests, distanceFieldMatchesRouteLengths)
+{
+    std::unique_ptr<Maze> maze = perfectMaze(8);
+    myBFSMazeSolver solver;
+    std::vector<uint32_t> distance;
+    solver.distanceField(*maze, {3, 4}, distance);
+    ASSERT_EQ(static_cast<size_t>(WIDTH * HEIGHT), distance.size());
+    std::vector<Direction> path;
+    for (int y = 0; y < HEIGHT; y++)
+    {
+        for (int x = 0; x < WIDTH; x++)
+        {
+            ASSERT_TRUE(solver.findPath(*maze, {3, 4}, {x, y}, path));
+            EXPECT_EQ(path.size(), distance[y * WIDTH + x]);
+        }
+    }
+}
+
+
+TEST(myBFSMazeSolver_SanityCheckTests, distanceFieldMarksUnreachableCells)
+{
+    std::unique_ptr<Maze> maze = MazeFactory{}.createMaze(3, 3);
+    maze->addAllWalls();
+    maze->removeWall(0, 0, Direction::down);
+    std::vector<uint32_t> distance;
+    myBFSMazeSolver{}.distanceField(*maze, {0, 0}, distance);
+    EXPECT_EQ(0u, distance[0]);
+    EXPECT_EQ(1u, distance[3]);
+    EXPECT_EQ(myBFSMazeSolver::UNREACHABLE, distance[1]);
+    EXPECT_EQ(myBFSMazeSolver::UNREACHABLE, distance[8]);
+}
+
+
+TEST(myBFSMazeSolver_SanityCheckTests, multiSourceFieldIsTheNearestSource)
+{
+    std::unique_ptr<Maze> maze = bandedMaze();
+    std::vector<std::pair<int,int>> sources = {{0, 0}, {WIDTH-1, HEIGHT-1}, {WIDTH/2, 10}};
+    myBFSMazeSolver solver;
+    std::vector<uint32_t> nearest;
+    solver.distanceField(*maze, sources, nearest);
+
+    std::vector<uint32_t> expected(WIDTH * HEIGHT, myBFSMazeSolver::UNREACHABLE);
+    std::vector<uint32_t> distance;
+    for (const std::pair<int,int>& source : sources)
+    {
+        solver.distanceField(*maze, source, distance);
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            expected[i] = std::min(expected[i], distance[i]);
+        }
+    }
+    EXPECT_EQ(expected, nearest);
+}
+
+
+TEST(myBFSMazeSolver_SanityCheckTests, windowedSearchesStayInTheWindow)
+{
+    // The only way from (1, 1) to (1, 3) goes round the end of the wall
+    // under row 2, at x = 6.
+    std::unique_ptr<Maze> maze = MazeFactory{}.createMaze(8, 6);
+    maze->removeAllWalls();
+    for (int x = 0; x < 6; x++)
+    {
+        maze->addWall(x, 2, Direction::down);
+    }
+    myBFSMazeSolver solver;
+    std::vector<Direction> path;
+    EXPECT_TRUE(solver.findPath(*maze, {1, 1}, {1, 3}, {0, 0, 8, 6}, path));
+    EXPECT_TRUE(isRoute(*maze, {1, 1}, {1, 3}, path));
+    EXPECT_EQ(12u, path.size());
+    EXPECT_FALSE(solver.findPath(*maze, {1, 1}, {1, 3}, {0, 0, 6, 6}, path));
+    EXPECT_FALSE(solver.findPath(*maze, {1, 1}, {7, 5}, {0, 0, 4, 4}, path));
+
+    std::vector<uint32_t> distance;
+    solver.distanceField(*maze, {3, 4}, {1, 3, 5, 3}, distance);
+    ASSERT_EQ(15u, distance.size());
+    EXPECT_EQ(0u, distance[1 * 5 + 2]);
+    EXPECT_EQ(3u, distance[0 * 5 + 0]);
+    EXPECT_EQ(3u, distance[2 * 5 + 4]);
+}
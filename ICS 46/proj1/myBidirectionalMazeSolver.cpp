@@ -0,0 +1,145 @@
+#include "myBidirectionalMazeSolver.hpp"
+#include "MazeSearch.hpp"
+#include <ics46/factory/DynamicFactory.hpp>
+#include <algorithm>
+#include <thread>
+using namespace std;
+
+ICS46_DYNAMIC_FACTORY_REGISTER(MazeSolver, myBidirectionalMazeSolver, "Richard's Bidirectional MazeSolver (two threads)");
+
+void myBidirectionalMazeSolver::solveMaze(const Maze& maze, MazeSolution& mazeSolution)
+{
+    if (findPath(maze,mazeSolution.getStartingCell(),mazeSolution.getEndingCell(),path))
+    {
+        MazeSearch::writePath(path,mazeSolution);
+    }
+}
+
+unsigned int myBidirectionalMazeSolver::claim(size_t cell,int side)
+{
+    unsigned int shift = (cell & 31) * 2;
+    uint64_t bit = uint64_t{1} << (shift + side);
+    uint64_t before = owner[cell >> 5].fetch_or(bit, memory_order_relaxed);
+    return (before >> shift) & 3;
+}
+
+// Both threads only read the Maze.  Each one writes cameFrom[side] for the
+// cells it claimed, so the arrays are never shared while the threads run;
+// the route is put together after both have been joined.
+bool myBidirectionalMazeSolver::findPath(const Maze& maze,pair<int,int> start,pair<int,int> end,vector<Direction>& path)
+{
+    int width = maze.getWidth();
+    size_t cells = static_cast<size_t>(width) * maze.getHeight();
+
+    if (owner.size() != (cells + 31) / 32)
+    {
+        vector<atomic<uint64_t>> resized((cells + 31) / 32);
+        owner.swap(resized);
+    }
+    for (atomic<uint64_t>& word : owner)
+    {
+        word.store(0, memory_order_relaxed);
+    }
+    cameFrom[FROM_START].resize(cells);
+    cameFrom[FROM_END].resize(cells);
+    met = false;
+    path.clear();
+
+    if (start == end)
+    {
+        expanded[FROM_START] = expanded[FROM_END] = 0;
+        return true;
+    }
+
+    claim(MazeSearch::cellIndex(start.first,start.second,width),FROM_START);
+    claim(MazeSearch::cellIndex(end.first,end.second,width),FROM_END);
+
+    thread other{[&]() { search(maze,FROM_END,end); }};
+    search(maze,FROM_START,start);
+    other.join();
+
+    if (!met)
+    {
+        return false;
+    }
+
+    // The thread that noticed the meeting stood on one side of a single
+    // step; the rest of the route is traced back through each side's
+    // cameFrom[] to its own end.
+    int meetingX = meetingCell % width;
+    int meetingY = meetingCell / width;
+    int otherX = meetingX;
+    int otherY = meetingY;
+    MazeSearch::step(meetingDirection,otherX,otherY);
+
+    pair<int,int> startSideCell{meetingX,meetingY};
+    pair<int,int> endSideCell{otherX,otherY};
+    Direction crossing = meetingDirection;
+    if (meetingSide == FROM_END)
+    {
+        swap(startSideCell,endSideCell);
+        crossing = MazeSearch::opposite(meetingDirection);
+    }
+
+    MazeSearch::tracePath(cameFrom[FROM_START],width,start,startSideCell,path);
+    path.push_back(crossing);
+
+    vector<Direction> back;
+    MazeSearch::tracePath(cameFrom[FROM_END],width,end,endSideCell,back);
+    for (auto i = back.rbegin(); i != back.rend(); ++i)
+    {
+        path.push_back(MazeSearch::opposite(*i));
+    }
+    return true;
+}
+
+void myBidirectionalMazeSolver::search(const Maze& maze,int side,pair<int,int> from)
+{
+    int width = maze.getWidth();
+    vector<int>& frontier = queue[side];
+    vector<unsigned char>& entered = cameFrom[side];
+    frontier.clear();
+    frontier.push_back(static_cast<int>(MazeSearch::cellIndex(from.first,from.second,width)));
+    expanded[side] = 0;
+
+    for (size_t head = 0; head < frontier.size() && !met.load(memory_order_relaxed); head++)
+    {
+        int cell = frontier[head];
+        expanded[side]++;
+        int x = cell % width;
+        int y = cell / width;
+        for (Direction direction : MazeSearch::directions)
+        {
+            if (!MazeSearch::canMove(maze,x,y,direction))
+            {
+                continue;
+            }
+            int xc = x;
+            int yc = y;
+            MazeSearch::step(direction,xc,yc);
+            size_t next = MazeSearch::cellIndex(xc,yc,width);
+            unsigned int before = claim(next,side);
+            if (before & (1u << (1 - side)))
+            {
+                bool expected = false;
+                if (met.compare_exchange_strong(expected, true))
+                {
+                    meetingSide = side;
+                    meetingCell = cell;
+                    meetingDirection = direction;
+                }
+                return;
+            }
+            if (!(before & (1u << side)))
+            {
+                entered[next] = static_cast<unsigned char>(direction);
+                frontier.push_back(static_cast<int>(next));
+            }
+        }
+    }
+}
+
+long long myBidirectionalMazeSolver::getNodesExpanded() const
+{
+    return expanded[FROM_START] + expanded[FROM_END];
+}
@@ -0,0 +1,52 @@
+#ifndef MYBIDIRECTIONALMAZESOLVER_HPP
+#define MYBIDIRECTIONALMAZESOLVER_HPP
+
+#include "MazeSolver.hpp"
+#include "MazeSolution.hpp"
+#include "Direction.hpp"
+#include "Maze.hpp"
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// Searches breadth-first from the starting and ending cells at the same
+// time, one thread per side, and stops when the two frontiers touch.
+// Cells are claimed in a shared bitmap holding two ownership bits per cell;
+// a thread that finds the other side's bit already set has found the
+// meeting point.  On a long corridor each side only explores about half.
+class myBidirectionalMazeSolver: public MazeSolver
+{
+public:
+    void solveMaze(const Maze& maze, MazeSolution& mazeSolution) override;
+    bool findPath(const Maze& maze,pair<int,int> start,pair<int,int> end,vector<Direction>& path);
+
+    // Cells expanded by both threads together in the last search.
+    long long getNodesExpanded() const;
+
+private:
+    static constexpr int FROM_START = 0;
+    static constexpr int FROM_END = 1;
+
+    void search(const Maze& maze,int side,pair<int,int> from);
+
+    // claim() marks the cell as owned by side and returns the bits that
+    // were set before.
+    unsigned int claim(size_t cell,int side);
+
+private:
+    vector<atomic<uint64_t>> owner;
+    vector<unsigned char> cameFrom[2];
+    vector<int> queue[2];
+    long long expanded[2] = {0, 0};
+
+    atomic<bool> met{false};
+    int meetingSide = FROM_START;
+    int meetingCell = 0;
+    Direction meetingDirection = Direction::up;
+
+    vector<Direction> path;
+};
+
+#endif
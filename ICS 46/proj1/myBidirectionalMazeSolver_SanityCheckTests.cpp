@@ -0,0 +1,69 @@
+// myBidirectionalMazeSolver_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks that the two searches meet on a shortest route, including the
+// edge cases where they start on the same or neighbouring cells.  Run
+// these under ThreadSanitizer too.
+
+#include <gtest/gtest.h>
+#include "myBidirectionalMazeSolver.hpp"
+#include "MazeSolutionFactory.hpp"
+#include "MazeSanityChecks.hpp"
+#include <vector>
+
+using namespace MazeSanityChecks;
+
+
+TEST(myBidirectionalMazeSolver_SanityCheckTests, solvesPerfectMazes)
+{
+    myBidirectionalMazeSolver solver;
+    for (uint64_t seed : {5, 6})
+    {
+        std::unique_ptr<Maze> maze = perfectMaze(seed);
+        std::unique_ptr<MazeSolution> solution = MazeSolutionFactory{}.createMazeSolution(WIDTH, HEIGHT);
+        solver.solveMaze(*maze, *solution);
+        EXPECT_TRUE(solvedCorrectly(*maze, *solution)) << "seed " << seed;
+    }
+}
+
+
+TEST(myBidirectionalMazeSolver_SanityCheckTests, findsTheShortestRouteThroughLoops)
+{
+    std::unique_ptr<Maze> maze = bandedMaze();
+    std::pair<int,int> start{0, 0};
+    std::pair<int,int> end{WIDTH-1, HEIGHT-1};
+    std::vector<Direction> path;
+    for (int run = 0; run < 20; run++)
+    {
+        ASSERT_TRUE(myBidirectionalMazeSolver{}.findPath(*maze, start, end, path));
+        EXPECT_TRUE(isRoute(*maze, start, end, path));
+        EXPECT_EQ(static_cast<size_t>(WIDTH + HEIGHT - 2), path.size());
+    }
+}
+
+
+TEST(myBidirectionalMazeSolver_SanityCheckTests, handlesNearbyEnds)
+{
+    std::unique_ptr<Maze> maze = perfectMaze(11);
+    myBidirectionalMazeSolver solver;
+    std::vector<Direction> path;
+    EXPECT_TRUE(solver.findPath(*maze, {3, 3}, {3, 3}, path));
+    EXPECT_TRUE(path.empty());
+
+    std::unique_ptr<Maze> open = MazeFactory{}.createMaze(2, 1);
+    open->removeAllWalls();
+    EXPECT_TRUE(solver.findPath(*open, {0, 0}, {1, 0}, path));
+    EXPECT_TRUE(isRoute(*open, {0, 0}, {1, 0}, path));
+    EXPECT_EQ(1u, path.size());
+}
+
+
+TEST(myBidirectionalMazeSolver_SanityCheckTests, reportsAnUnreachableEnd)
+{
+    std::unique_ptr<Maze> maze = MazeFactory{}.createMaze(4, 4);
+    maze->addAllWalls();
+    std::vector<Direction> path;
+    EXPECT_FALSE(myBidirectionalMazeSolver{}.findPath(*maze, {0, 0}, {3, 3}, path));
+}
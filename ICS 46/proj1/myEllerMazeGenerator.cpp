@@ -0,0 +1,184 @@
+#include "myEllerMazeGenerator.hpp"
+#include <ics46/factory/DynamicFactory.hpp>
+#include <string>
+using namespace std;
+
+ICS46_DYNAMIC_FACTORY_REGISTER(MazeGenerator,myEllerMazeGenerator,"Richard's Eller MazeGenerator (row by row)");
+
+void myEllerMazeGenerator::generateMaze(Maze& maze)
+{
+    maze.addAllWalls();
+    generateRows(maze.getWidth(), maze.getHeight(),
+        [&](int y, const vector<bool>& right, const vector<bool>& down)
+        {
+            for (int x = 0; x < maze.getWidth(); x++)
+            {
+                if (!right[x])
+                {
+                    maze.removeWall(x,y,Direction::right);
+                }
+                if (!down[x])
+                {
+                    maze.removeWall(x,y,Direction::down);
+                }
+            }
+        });
+}
+
+void myEllerMazeGenerator::setSeed(uint64_t seed)
+{
+    random.seed(seed);
+}
+
+void myEllerMazeGenerator::setRandom(const MazeRandom& random)
+{
+    this->random = random;
+}
+
+void myEllerMazeGenerator::generateRows(int width,int height,ostream& out)
+{
+    out << width << " " << height << "\n";
+    string line(width, '0');
+    generateRows(width, height,
+        [&](int, const vector<bool>& right, const vector<bool>& down)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                line[x] = '0' + right[x] + 2 * down[x];
+            }
+            out << line << "\n";
+        });
+}
+
+void myEllerMazeGenerator::generateRows(int width,int height,MazeBitboardWriter& writer)
+{
+    generateRows(width, height,
+        [&](int, const vector<bool>& right, const vector<bool>& down)
+        {
+            writer.writeRow(right, down);
+        });
+}
+
+void myEllerMazeGenerator::generateRows(int width,int height,RowCallback callback)
+{
+    label.resize(width);
+    parent.resize(width);
+    remaining.resize(width);
+    droppedSet.resize(width);
+    used.resize(width);
+    rightWall.resize(width);
+    downWall.resize(width);
+
+    for (int x = 0; x < width; x++)
+    {
+        label[x] = x;
+    }
+
+    for (int y = 0; y < height; y++)
+    {
+        bool lastRow = y == height-1;
+        joinRow(width,lastRow);
+        if (lastRow)
+        {
+            downWall.assign(width, true);
+        }
+        else
+        {
+            dropRow(width);
+        }
+        callback(y,rightWall,downWall);
+        if (!lastRow)
+        {
+            relabelRow(width);
+        }
+    }
+}
+
+int myEllerMazeGenerator::find(int label)
+{
+    while (parent[label] != label)
+    {
+        parent[label] = parent[parent[label]];
+        label = parent[label];
+    }
+    return label;
+}
+
+// Randomly knocks down walls between neighbours in different sets; on the
+// last row every such wall goes so the whole maze ends up connected.
+void myEllerMazeGenerator::joinRow(int width,bool lastRow)
+{
+    for (int x = 0; x < width; x++)
+    {
+        parent[x] = x;
+    }
+    for (int x = 0; x < width; x++)
+    {
+        rightWall[x] = true;
+        if (x+1 < width)
+        {
+            int a = find(label[x]);
+            int b = find(label[x+1]);
+            if (a != b && (lastRow || random.coin()))
+            {
+                parent[b] = a;
+                rightWall[x] = false;
+            }
+        }
+    }
+}
+
+// Opens at least one down wall per set so no set is cut off from the next
+// row.  remaining[] counts the cells of each set not decided yet; the last
+// one is forced down if nothing in its set has dropped so far.
+void myEllerMazeGenerator::dropRow(int width)
+{
+    for (int x = 0; x < width; x++)
+    {
+        remaining[x] = 0;
+        droppedSet[x] = false;
+    }
+    for (int x = 0; x < width; x++)
+    {
+        label[x] = find(label[x]);
+        remaining[label[x]]++;
+    }
+    for (int x = 0; x < width; x++)
+    {
+        int set = label[x];
+        remaining[set]--;
+        bool drop = random.coin() || (remaining[set] == 0 && !droppedSet[set]);
+        downWall[x] = !drop;
+        if (drop)
+        {
+            droppedSet[set] = true;
+        }
+    }
+}
+
+// Cells that dropped keep their set into the next row; the rest start new
+// sets using labels no dropped set is using.
+void myEllerMazeGenerator::relabelRow(int width)
+{
+    used.assign(width, false);
+    for (int x = 0; x < width; x++)
+    {
+        if (!downWall[x])
+        {
+            used[label[x]] = true;
+        }
+    }
+    int next = 0;
+    for (int x = 0; x < width; x++)
+    {
+        if (downWall[x])
+        {
+            while (used[next])
+            {
+                next++;
+            }
+            used[next] = true;
+            label[x] = next;
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef MYELLERMAZEGENERATOR_HPP
+#define MYELLERMAZEGENERATOR_HPP
+
+#include "MazeGenerator.hpp"
+#include "Maze.hpp"
+#include "Direction.hpp"
+#include "MazeBitboard.hpp"
+#include "MazeRandom.hpp"
+#include <functional>
+#include <ostream>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+// Eller's algorithm builds a perfect maze one row at a time, keeping only
+// the set each cell of the current row belongs to.  Working memory is
+// O(width) no matter how tall the maze is, so rows can be written out as
+// they are finished instead of holding the whole grid.
+class myEllerMazeGenerator: public MazeGenerator
+{
+public:
+    // A RowCallback receives each finished row: rightWall[x] says whether
+    // the wall between (x,y) and (x+1,y) is still there, downWall[x] the
+    // same for (x,y) and (x,y+1).  The last cell and last row always keep
+    // their outer walls.
+    using RowCallback = function<void(int y, const vector<bool>& rightWall, const vector<bool>& downWall)>;
+
+    void generateMaze(Maze& maze) override;
+
+    void generateRows(int width,int height,RowCallback callback);
+
+    // Writes "width height" on the first line, then one line per row with
+    // one digit per cell: 1 if the right wall is there, plus 2 if the down
+    // wall is there.
+    void generateRows(int width,int height,ostream& out);
+
+    // Writes the rows into a bitboard file that MazeBitboard::map() can
+    // load back.  The caller still calls writer.finish() afterwards.
+    void generateRows(int width,int height,MazeBitboardWriter& writer);
+
+    // setSeed() restarts the random sequence, so equal seeds and widths
+    // produce equal rows.
+    void setSeed(uint64_t seed);
+
+    // setRandom() continues from a copy of the given generator instead,
+    // e.g. one of several streams jumped apart from a single seed.
+    void setRandom(const MazeRandom& random);
+
+private:
+    int find(int label);
+    void joinRow(int width,bool lastRow);
+    void dropRow(int width);
+    void relabelRow(int width);
+
+private:
+    vector<int> label;
+    vector<int> parent;
+    vector<int> remaining;
+    vector<bool> droppedSet;
+    vector<bool> used;
+    vector<bool> rightWall;
+    vector<bool> downWall;
+    MazeRandom random;
+};
+
+#endif
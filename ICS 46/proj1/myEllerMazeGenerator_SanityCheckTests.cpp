@@ -0,0 +1,80 @@
+// myEllerMazeGenerator_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks that Eller's generator makes perfect mazes and that its streamed
+// rows describe the same maze generateMaze() builds.
+
+#include <gtest/gtest.h>
+#include "myEllerMazeGenerator.hpp"
+#include "MazeSanityChecks.hpp"
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace MazeSanityChecks;
+
+
+TEST(myEllerMazeGenerator_SanityCheckTests, makesPerfectMazes)
+{
+    myEllerMazeGenerator generator;
+    generator.setSeed(4);
+    EXPECT_TRUE(isPerfect(*generated(generator)));
+    EXPECT_TRUE(isPerfect(*generated(generator, 1, 1)));
+    EXPECT_TRUE(isPerfect(*generated(generator, 1, 9)));
+    EXPECT_TRUE(isPerfect(*generated(generator, 9, 1)));
+}
+
+
+TEST(myEllerMazeGenerator_SanityCheckTests, rowsMatchTheGeneratedMaze)
+{
+    myEllerMazeGenerator generator;
+    generator.setSeed(5);
+    std::unique_ptr<Maze> maze = generated(generator);
+
+    generator.setSeed(5);
+    int rows = 0;
+    generator.generateRows(WIDTH, HEIGHT,
+        [&](int y, const std::vector<bool>& rightWall, const std::vector<bool>& downWall)
+        {
+            EXPECT_EQ(rows, y);
+            rows++;
+            for (int x = 0; x < WIDTH; x++)
+            {
+                EXPECT_EQ(maze->wallExists(x, y, Direction::right), rightWall[x]);
+                EXPECT_EQ(maze->wallExists(x, y, Direction::down), downWall[x]);
+            }
+        });
+    EXPECT_EQ(HEIGHT, rows);
+}
+
+
+TEST(myEllerMazeGenerator_SanityCheckTests, textRowsKeepTheOuterWalls)
+{
+    myEllerMazeGenerator generator;
+    generator.setSeed(6);
+    std::ostringstream out;
+    generator.generateRows(5, 3, out);
+
+    std::istringstream in{out.str()};
+    int width = 0;
+    int height = 0;
+    in >> width >> height;
+    EXPECT_EQ(5, width);
+    EXPECT_EQ(3, height);
+    for (int y = 0; y < height; y++)
+    {
+        std::string row;
+        in >> row;
+        ASSERT_EQ(5u, row.size());
+        EXPECT_TRUE((row.back() - '0') & 1);
+        if (y == height - 1)
+        {
+            for (char cell : row)
+            {
+                EXPECT_TRUE((cell - '0') & 2);
+            }
+        }
+    }
+}
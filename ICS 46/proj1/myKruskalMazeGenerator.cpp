@@ -0,0 +1,217 @@
+#include "myKruskalMazeGenerator.hpp"
+#include <ics46/factory/DynamicFactory.hpp>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+using namespace std;
+
+ICS46_DYNAMIC_FACTORY_REGISTER(MazeGenerator,myKruskalMazeGenerator,"Richard's Kruskal MazeGenerator (union-find)");
+
+namespace
+{
+    // Runs work(0) .. work(count-1) on up to threads threads, the calling
+    // thread included.
+    template <typename Work>
+    void runParallel(unsigned int threads,int count,Work work)
+    {
+        threads = max(1u, min(threads, static_cast<unsigned int>(count)));
+        atomic<int> next{0};
+        auto run = [&]()
+        {
+            for (int i = next++; i < count; i = next++)
+            {
+                work(i);
+            }
+        };
+
+        vector<thread> workers;
+        for (unsigned int i = 1; i < threads; i++)
+        {
+            workers.emplace_back(run);
+        }
+        run();
+        for (thread& worker : workers)
+        {
+            worker.join();
+        }
+    }
+}
+
+unsigned int myKruskalMazeGenerator::getThreadCount() const
+{
+    return threadCount;
+}
+
+void myKruskalMazeGenerator::setThreadCount(unsigned int threadCount)
+{
+    this->threadCount = threadCount;
+}
+
+void myKruskalMazeGenerator::setSeed(uint64_t seed)
+{
+    random.seed(seed);
+}
+
+void myKruskalMazeGenerator::generateMaze(Maze& maze)
+{
+    int width = maze.getWidth();
+    int height = maze.getHeight();
+    maze.addAllWalls();
+    // An empty maze has no cells, and the count of passages below would
+    // wrap around.
+    if (width <= 0 || height <= 0)
+    {
+        return;
+    }
+    listWalls(width,height);
+    shuffleWalls();
+    parent.assign(static_cast<size_t>(width) * height, -1);
+
+    // A spanning tree has one passage fewer than there are cells, so the
+    // rest of the list needn't be looked at once they're all open.
+    size_t passages = parent.size() - 1;
+    for (size_t i = 0; i < walls.size() && passages > 0; i++)
+    {
+        uint32_t wall = walls[i];
+        int cell = wall / 2;
+        bool down = wall & 1;
+        int neighbour = down ? cell + width : cell + 1;
+        if (join(cell,neighbour))
+        {
+            maze.removeWall(cell % width, cell / width, down ? Direction::down : Direction::right);
+            passages--;
+        }
+    }
+}
+
+void myKruskalMazeGenerator::listWalls(int width,int height)
+{
+    walls.clear();
+    walls.reserve(static_cast<size_t>(width - 1) * height + static_cast<size_t>(width) * (height - 1));
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            uint32_t cell = static_cast<uint32_t>(y) * width + x;
+            if (x+1 < width)
+            {
+                walls.push_back(2 * cell);
+            }
+            if (y+1 < height)
+            {
+                walls.push_back(2 * cell + 1);
+            }
+        }
+    }
+}
+
+// A parallel shuffle that still gives every order the same chance: cut the
+// list into BUCKETS chunks, send each wall of a chunk to a random bucket,
+// lay the buckets out one after another, and shuffle each bucket on its
+// own.  Chunks and buckets each have their own generator, seeded from the
+// main one, so the threads only decide who does the work.
+void myKruskalMazeGenerator::shuffleWalls()
+{
+    size_t count = walls.size();
+    unsigned int threads = threadCount > 0 ? threadCount : thread::hardware_concurrency();
+    bucketOf.resize(count);
+    shuffled.resize(count);
+
+    vector<uint64_t> seeds(2 * BUCKETS);
+    for (uint64_t& seed : seeds)
+    {
+        seed = random();
+    }
+
+    auto chunkBegin = [&](int chunk)
+    {
+        return count * chunk / BUCKETS;
+    };
+
+    // sizes[chunk * BUCKETS + bucket] counts that chunk's walls sent to
+    // that bucket, and is then turned into where they start in shuffled[].
+    vector<size_t> sizes(BUCKETS * BUCKETS, 0);
+    runParallel(threads, BUCKETS, [&](int chunk)
+    {
+        MazeRandom chunkRandom{seeds[chunk]};
+        size_t* size = &sizes[chunk * BUCKETS];
+        for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk+1); i++)
+        {
+            unsigned char bucket = static_cast<unsigned char>(chunkRandom.below(BUCKETS));
+            bucketOf[i] = bucket;
+            size[bucket]++;
+        }
+    });
+
+    vector<size_t> bucketStart(BUCKETS + 1);
+    size_t offset = 0;
+    for (int bucket = 0; bucket < BUCKETS; bucket++)
+    {
+        bucketStart[bucket] = offset;
+        for (int chunk = 0; chunk < BUCKETS; chunk++)
+        {
+            size_t size = sizes[chunk * BUCKETS + bucket];
+            sizes[chunk * BUCKETS + bucket] = offset;
+            offset += size;
+        }
+    }
+    bucketStart[BUCKETS] = offset;
+
+    runParallel(threads, BUCKETS, [&](int chunk)
+    {
+        size_t* position = &sizes[chunk * BUCKETS];
+        for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk+1); i++)
+        {
+            shuffled[position[bucketOf[i]]++] = walls[i];
+        }
+    });
+
+    runParallel(threads, BUCKETS, [&](int bucket)
+    {
+        MazeRandom bucketRandom{seeds[BUCKETS + bucket]};
+        uint32_t* first = shuffled.data() + bucketStart[bucket];
+        size_t size = bucketStart[bucket+1] - bucketStart[bucket];
+        for (size_t i = size; i > 1; i--)
+        {
+            swap(first[i-1], first[bucketRandom.below(static_cast<uint32_t>(i))]);
+        }
+    });
+
+    walls.swap(shuffled);
+}
+
+// Path halving: every cell on the way up is pointed at its grandparent,
+// which flattens the tree as much as full compression over time without
+// a second pass or recursion.
+int myKruskalMazeGenerator::find(int cell)
+{
+    while (parent[cell] >= 0)
+    {
+        int up = parent[cell];
+        if (parent[up] >= 0)
+        {
+            parent[cell] = parent[up];
+        }
+        cell = parent[cell];
+    }
+    return cell;
+}
+
+// Joins the sets of a and b, the smaller under the larger, and returns
+// false if they were already one set.
+bool myKruskalMazeGenerator::join(int a,int b)
+{
+    a = find(a);
+    b = find(b);
+    if (a == b)
+    {
+        return false;
+    }
+    if (parent[a] > parent[b])
+    {
+        swap(a, b);
+    }
+    parent[a] += parent[b];
+    parent[b] = a;
+    return true;
+}
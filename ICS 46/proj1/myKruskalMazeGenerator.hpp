@@ -0,0 +1,52 @@
+#ifndef MYKRUSKALMAZEGENERATOR_HPP
+#define MYKRUSKALMAZEGENERATOR_HPP
+
+#include "MazeGenerator.hpp"
+#include "Maze.hpp"
+#include "Direction.hpp"
+#include "MazeRandom.hpp"
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+// Kruskal's algorithm: put every interior wall in a list, shuffle it, and
+// knock a wall down whenever the cells on its two sides aren't connected
+// yet, which a union-find over the cells answers.  There is no recursion,
+// and memory is fixed by the maze size: two 4-byte wall lists, a byte per
+// wall while shuffling, and one int per cell for the union-find.  The
+// mazes have many short dead ends rather than the backtracker's long
+// winding corridors.
+class myKruskalMazeGenerator: public MazeGenerator
+{
+public:
+    void generateMaze(Maze& maze) override;
+
+    // The shuffle runs on this many threads; 0 means one per core.  The
+    // maze depends only on the seed, not on the thread count.
+    unsigned int getThreadCount() const;
+    void setThreadCount(unsigned int threadCount);
+
+    void setSeed(uint64_t seed);
+
+private:
+    // Walls are numbered 2 * cell for the right wall of a cell and
+    // 2 * cell + 1 for its down wall.
+    void listWalls(int width,int height);
+    void shuffleWalls();
+    int find(int cell);
+    bool join(int a,int b);
+
+private:
+    static constexpr int BUCKETS = 256;
+
+    vector<uint32_t> walls;
+    vector<uint32_t> shuffled;
+    vector<unsigned char> bucketOf;
+
+    // parent[cell] is the parent cell, or minus the set's size at a root.
+    vector<int> parent;
+    unsigned int threadCount = 0;
+    MazeRandom random;
+};
+
+#endif
@@ -0,0 +1,50 @@
+// myKruskalMazeGenerator_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks that Kruskal's generator makes perfect mazes whatever its thread
+// count, makes the same maze from the same seed on any number of threads,
+// and leaves empty mazes alone.  Run these under ThreadSanitizer too.
+
+#include <gtest/gtest.h>
+#include "myKruskalMazeGenerator.hpp"
+#include "MazeSanityChecks.hpp"
+
+using namespace MazeSanityChecks;
+
+
+TEST(myKruskalMazeGenerator_SanityCheckTests, makesPerfectMazes)
+{
+    for (unsigned int threads : {1u, 4u})
+    {
+        myKruskalMazeGenerator generator;
+        generator.setSeed(4);
+        generator.setThreadCount(threads);
+        EXPECT_TRUE(isPerfect(*generated(generator)));
+        EXPECT_TRUE(isPerfect(*generated(generator, 1, 1)));
+        EXPECT_TRUE(isPerfect(*generated(generator, 9, 1)));
+        EXPECT_TRUE(isPerfect(*generated(generator, 1, 9)));
+    }
+}
+
+
+TEST(myKruskalMazeGenerator_SanityCheckTests, isTheSameForAnyThreadCount)
+{
+    myKruskalMazeGenerator generator;
+    generator.setSeed(19);
+    generator.setThreadCount(1);
+    std::unique_ptr<Maze> single = generated(generator, 300, 40);
+    generator.setSeed(19);
+    generator.setThreadCount(4);
+    EXPECT_TRUE(sameWalls(*single, *generated(generator, 300, 40)));
+}
+
+
+TEST(myKruskalMazeGenerator_SanityCheckTests, leavesEmptyMazesAlone)
+{
+    myKruskalMazeGenerator generator;
+    EXPECT_EQ(0, generated(generator, 0, 5)->getWidth());
+    EXPECT_EQ(0, generated(generator, 5, 0)->getHeight());
+    EXPECT_EQ(0, generated(generator, 0, 0)->getWidth());
+}
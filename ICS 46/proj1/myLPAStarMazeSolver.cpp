@@ -0,0 +1,228 @@
+#include "myLPAStarMazeSolver.hpp"
+#include "MazeSearch.hpp"
+#include <ics46/factory/DynamicFactory.hpp>
+#include <algorithm>
+#include <cstdlib>
+using namespace std;
+
+ICS46_DYNAMIC_FACTORY_REGISTER(MazeSolver, myLPAStarMazeSolver, "Richard's LPA* MazeSolver (shortest path, repairable)");
+
+namespace
+{
+    struct LaterInOrder
+    {
+        template <typename OpenCell>
+        bool operator()(const OpenCell& a, const OpenCell& b) const
+        {
+            return b.key < a.key;
+        }
+    };
+}
+
+bool myLPAStarMazeSolver::Key::operator<(const Key& other) const
+{
+    return estimate != other.estimate ? estimate < other.estimate : cost < other.cost;
+}
+
+bool myLPAStarMazeSolver::Key::operator==(const Key& other) const
+{
+    return estimate == other.estimate && cost == other.cost;
+}
+
+void myLPAStarMazeSolver::solveMaze(const Maze& maze, MazeSolution& mazeSolution)
+{
+    if (begin(maze,mazeSolution.getStartingCell(),mazeSolution.getEndingCell()))
+    {
+        MazeSearch::writePath(path,mazeSolution);
+    }
+}
+
+bool myLPAStarMazeSolver::begin(const Maze& maze,pair<int,int> start,pair<int,int> end)
+{
+    this->maze = &maze;
+    this->end = end;
+    width = maze.getWidth();
+    size_t cells = static_cast<size_t>(width) * maze.getHeight();
+    g.assign(cells, INFINITE);
+    rhs.assign(cells, INFINITE);
+    open.clear();
+    startCell = static_cast<int>(MazeSearch::cellIndex(start.first,start.second,width));
+    endCell = static_cast<int>(MazeSearch::cellIndex(end.first,end.second,width));
+
+    rhs[startCell] = 0;
+    push({keyOf(startCell), startCell});
+    return search();
+}
+
+const vector<Direction>& myLPAStarMazeSolver::getPath() const
+{
+    return path;
+}
+
+long long myLPAStarMazeSolver::getNodesExpanded() const
+{
+    return nodesExpanded;
+}
+
+// The key orders the open list like A*: by estimated route length through
+// the cell, then by distance from the start.  An inconsistent cell is
+// ranked by the smaller of its two distances.
+myLPAStarMazeSolver::Key myLPAStarMazeSolver::keyOf(int cell) const
+{
+    uint32_t cost = min(g[cell], rhs[cell]);
+    if (cost == INFINITE)
+    {
+        return {INFINITE, INFINITE};
+    }
+    int x = cell % width;
+    int y = cell / width;
+    uint32_t heuristic = abs(x - end.first) + abs(y - end.second);
+    return {cost + heuristic, cost};
+}
+
+uint32_t myLPAStarMazeSolver::bestNeighbour(int cell) const
+{
+    int x = cell % width;
+    int y = cell / width;
+    uint32_t best = INFINITE;
+    for (Direction direction : MazeSearch::directions)
+    {
+        if (!MazeSearch::canMove(*maze,x,y,direction))
+        {
+            continue;
+        }
+        int xc = x;
+        int yc = y;
+        MazeSearch::step(direction,xc,yc);
+        uint32_t neighbour = g[MazeSearch::cellIndex(xc,yc,width)];
+        if (neighbour != INFINITE)
+        {
+            best = min(best, neighbour + 1);
+        }
+    }
+    return best;
+}
+
+// Recomputes rhs and queues the cell if it's now inconsistent.  The open
+// list isn't searched for an older entry; pop() drops entries whose key
+// is out of date or whose cell has become consistent.
+void myLPAStarMazeSolver::updateCell(int cell)
+{
+    if (cell != startCell)
+    {
+        rhs[cell] = bestNeighbour(cell);
+    }
+    if (g[cell] != rhs[cell])
+    {
+        push({keyOf(cell), cell});
+    }
+}
+
+// Only the two cells on either side of the wall can have a different
+// best neighbour; search() spreads the change from there.
+bool myLPAStarMazeSolver::wallChanged(int x,int y,Direction direction)
+{
+    int xc = x;
+    int yc = y;
+    MazeSearch::step(direction,xc,yc);
+    updateCell(static_cast<int>(MazeSearch::cellIndex(x,y,width)));
+    if (xc >= 0 && yc >= 0 && xc < width && yc < maze->getHeight())
+    {
+        updateCell(static_cast<int>(MazeSearch::cellIndex(xc,yc,width)));
+    }
+    return search();
+}
+
+void myLPAStarMazeSolver::push(OpenCell openCell)
+{
+    open.push_back(openCell);
+    push_heap(open.begin(), open.end(), LaterInOrder{});
+}
+
+myLPAStarMazeSolver::OpenCell myLPAStarMazeSolver::pop()
+{
+    pop_heap(open.begin(), open.end(), LaterInOrder{});
+    OpenCell openCell = open.back();
+    open.pop_back();
+    return openCell;
+}
+
+bool myLPAStarMazeSolver::search()
+{
+    nodesExpanded = 0;
+    while (open.size() > 0)
+    {
+        // Entries left behind by updateCell() are dropped here.
+        OpenCell top = open.front();
+        if (g[top.cell] == rhs[top.cell] || !(top.key == keyOf(top.cell)))
+        {
+            pop();
+            continue;
+        }
+        if (!(top.key < keyOf(endCell)) && g[endCell] == rhs[endCell])
+        {
+            break;
+        }
+        pop();
+        nodesExpanded++;
+
+        int cell = top.cell;
+        if (g[cell] > rhs[cell])
+        {
+            g[cell] = rhs[cell];
+        }
+        else
+        {
+            g[cell] = INFINITE;
+            updateCell(cell);
+        }
+
+        int x = cell % width;
+        int y = cell / width;
+        for (Direction direction : MazeSearch::directions)
+        {
+            if (MazeSearch::canMove(*maze,x,y,direction))
+            {
+                int xc = x;
+                int yc = y;
+                MazeSearch::step(direction,xc,yc);
+                updateCell(static_cast<int>(MazeSearch::cellIndex(xc,yc,width)));
+            }
+        }
+    }
+
+    path.clear();
+    if (g[endCell] == INFINITE)
+    {
+        return false;
+    }
+
+    // Walk back from the end, always to a neighbour one step closer.
+    int x = end.first;
+    int y = end.second;
+    int cell = endCell;
+    while (cell != startCell)
+    {
+        for (Direction direction : MazeSearch::directions)
+        {
+            if (!MazeSearch::canMove(*maze,x,y,direction))
+            {
+                continue;
+            }
+            int xc = x;
+            int yc = y;
+            MazeSearch::step(direction,xc,yc);
+            int neighbour = static_cast<int>(MazeSearch::cellIndex(xc,yc,width));
+            if (g[neighbour] != INFINITE && g[neighbour] + 1 == g[cell])
+            {
+                path.push_back(MazeSearch::opposite(direction));
+                x = xc;
+                y = yc;
+                cell = neighbour;
+                break;
+            }
+        }
+    }
+    reverse(path.begin(), path.end());
+    return true;
+}
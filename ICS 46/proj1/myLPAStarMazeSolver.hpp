@@ -0,0 +1,81 @@
+#ifndef MYLPASTARMAZESOLVER_HPP
+#define MYLPASTARMAZESOLVER_HPP
+
+#include "MazeSolver.hpp"
+#include "MazeSolution.hpp"
+#include "Direction.hpp"
+#include "Maze.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// Lifelong Planning A*: a shortest-path search that keeps its state after
+// finishing, so when a wall is added or removed only the cells whose
+// distance from the start actually changed are searched again.  Every
+// cell has g (its settled distance) and rhs (one more than its best open
+// neighbour's g); cells where the two differ sit in the open list, and
+// an edit only touches the rhs of the two cells on either side of the
+// wall.  The start never moves, so the plain forward form is used rather
+// than D* Lite.
+//
+// Call begin() once on a maze, then wallChanged() after every wall that
+// is added to or removed from it.
+class myLPAStarMazeSolver: public MazeSolver
+{
+public:
+    void solveMaze(const Maze& maze, MazeSolution& mazeSolution) override;
+
+    // begin() searches maze from scratch and returns whether end can be
+    // reached.  The solver keeps a pointer to the maze for later repairs.
+    bool begin(const Maze& maze,pair<int,int> start,pair<int,int> end);
+
+    // wallChanged() repairs the route after the wall on the given side of
+    // (x, y) was added or removed, and returns whether end can still be
+    // reached.
+    bool wallChanged(int x,int y,Direction direction);
+
+    // The current shortest route, valid while the last search found one.
+    const vector<Direction>& getPath() const;
+
+    // Cells expanded by begin() or by the repair after the last edit.
+    long long getNodesExpanded() const;
+
+private:
+    static constexpr uint32_t INFINITE = UINT32_MAX;
+
+    struct Key
+    {
+        uint32_t estimate;
+        uint32_t cost;
+        bool operator<(const Key& other) const;
+        bool operator==(const Key& other) const;
+    };
+
+    struct OpenCell
+    {
+        Key key;
+        int cell;
+    };
+
+    Key keyOf(int cell) const;
+    uint32_t bestNeighbour(int cell) const;
+    void updateCell(int cell);
+    bool search();
+    void push(OpenCell openCell);
+    OpenCell pop();
+
+private:
+    const Maze* maze = nullptr;
+    int width = 0;
+    int startCell = 0;
+    int endCell = 0;
+    pair<int,int> end;
+    vector<uint32_t> g;
+    vector<uint32_t> rhs;
+    vector<OpenCell> open;
+    vector<Direction> path;
+    long long nodesExpanded = 0;
+};
+
+#endif
@@ -0,0 +1,89 @@
+// myLPAStarMazeSolver_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks that every repair after a wall opens or closes leaves a route as
+// short as solving the changed maze again from scratch.
+
+#include <gtest/gtest.h>
+#include "myLPAStarMazeSolver.hpp"
+#include "myBFSMazeSolver.hpp"
+#include "MazeSolutionFactory.hpp"
+#include "MazeSanityChecks.hpp"
+#include <vector>
+
+using namespace MazeSanityChecks;
+
+
+TEST(myLPAStarMazeSolver_SanityCheckTests, solvesPerfectMazes)
+{
+    myLPAStarMazeSolver solver;
+    for (uint64_t seed : {5, 6})
+    {
+        std::unique_ptr<Maze> maze = perfectMaze(seed);
+        std::unique_ptr<MazeSolution> solution = MazeSolutionFactory{}.createMazeSolution(WIDTH, HEIGHT);
+        solver.solveMaze(*maze, *solution);
+        EXPECT_TRUE(solvedCorrectly(*maze, *solution)) << "seed " << seed;
+    }
+}
+
+
+TEST(myLPAStarMazeSolver_SanityCheckTests, findsTheShortestRouteThroughLoops)
+{
+    std::unique_ptr<Maze> maze = bandedMaze();
+    myLPAStarMazeSolver solver;
+    EXPECT_TRUE(solver.begin(*maze, {0, 0}, {WIDTH-1, HEIGHT-1}));
+    EXPECT_TRUE(isRoute(*maze, {0, 0}, {WIDTH-1, HEIGHT-1}, solver.getPath()));
+    EXPECT_EQ(static_cast<size_t>(WIDTH + HEIGHT - 2), solver.getPath().size());
+}
+
+
+TEST(myLPAStarMazeSolver_SanityCheckTests, repairsMatchASolveFromScratch)
+{
+    std::unique_ptr<Maze> maze = perfectMaze(7);
+    std::pair<int,int> start{0, 0};
+    std::pair<int,int> end{WIDTH-1, HEIGHT-1};
+    myLPAStarMazeSolver lpa;
+    ASSERT_TRUE(lpa.begin(*maze, start, end));
+
+    std::vector<Direction> fresh;
+    for (int x = 1; x+1 < WIDTH; x += 5)
+    {
+        int y = (x * 7) % (HEIGHT-1);
+        if (maze->wallExists(x, y, Direction::down))
+        {
+            maze->removeWall(x, y, Direction::down);
+            EXPECT_TRUE(lpa.wallChanged(x, y, Direction::down));
+
+            ASSERT_TRUE(myBFSMazeSolver{}.findPath(*maze, start, end, fresh));
+            EXPECT_TRUE(isRoute(*maze, start, end, lpa.getPath()));
+            EXPECT_EQ(fresh.size(), lpa.getPath().size());
+        }
+    }
+
+    // Closing a wall on the current route makes it take a detour.
+    Direction first = lpa.getPath().front();
+    maze->addWall(start.first, start.second, first);
+    bool reachable = myBFSMazeSolver{}.findPath(*maze, start, end, fresh);
+    EXPECT_EQ(reachable, lpa.wallChanged(start.first, start.second, first));
+    if (reachable)
+    {
+        EXPECT_TRUE(isRoute(*maze, start, end, lpa.getPath()));
+        EXPECT_EQ(fresh.size(), lpa.getPath().size());
+    }
+}
+
+
+TEST(myLPAStarMazeSolver_SanityCheckTests, reportsWhenTheEndIsCutOff)
+{
+    std::unique_ptr<Maze> maze = MazeFactory{}.createMaze(3, 1);
+    maze->removeAllWalls();
+    myLPAStarMazeSolver solver;
+    ASSERT_TRUE(solver.begin(*maze, {0, 0}, {2, 0}));
+    maze->addWall(1, 0, Direction::right);
+    EXPECT_FALSE(solver.wallChanged(1, 0, Direction::right));
+    maze->removeWall(1, 0, Direction::right);
+    EXPECT_TRUE(solver.wallChanged(1, 0, Direction::right));
+    EXPECT_EQ(2u, solver.getPath().size());
+}
@@ -1,59 +1,96 @@
 #include "myMazeGenerator.hpp"
+#include "MazeTrace.hpp"
+#include "NeighbourMask.hpp"
 #include <ics46/factory/DynamicFactory.hpp>
+#include <algorithm>
+#include <atomic>
 using namespace std;
 
 ICS46_DYNAMIC_FACTORY_REGISTER(MazeGenerator,myMazeGenerator,"Richard's MazeGenerator(Required)");
 
-void myMazeGenerator::generateMaze(Maze& maze)
+myMazeGenerator::myMazeGenerator(Mode mode)
+    : mode{mode}
 {
-	maze.addAllWalls();
-    visit.resize(maze.getWidth(), vector<bool>(maze.getHeight(), false));
-	generatingMaze(0,0,maze);
 }
 
-vector<Direction> myMazeGenerator::getDirections(int x,int y,Maze& maze)
+myMazeGenerator::Mode myMazeGenerator::getMode() const
 {
-	vector<Direction> direction;
-    if (x-1 >= 0)
-    {
-        if (visit[x-1][y] == false)
-        {
-            direction.push_back(Direction::left);
-        }
-    }
+    return mode;
+}
+
+void myMazeGenerator::setMode(Mode mode)
+{
+    this->mode = mode;
+}
+
+unsigned int myMazeGenerator::getThreadCount() const
+{
+    return threadCount;
+}
+
+void myMazeGenerator::setThreadCount(unsigned int threadCount)
+{
+    this->threadCount = threadCount;
+}
+
+void myMazeGenerator::setTileSize(int tileSize)
+{
+    this->tileSize = tileSize > 0 ? tileSize : DEFAULT_TILE_SIZE;
+}
+
+void myMazeGenerator::setSeed(uint64_t seed)
+{
+    random.seed(seed);
+}
 
-    if (x+1 < maze.getWidth())
+BitGrid::Layout myMazeGenerator::getGridLayout() const
+{
+    return visit.getLayout();
+}
+
+void myMazeGenerator::setGridLayout(BitGrid::Layout layout)
+{
+    visit.setLayout(layout);
+}
+
+const MazeCounters& myMazeGenerator::getCounters() const
+{
+    return counters;
+}
+
+void myMazeGenerator::generateMaze(Maze& maze)
+{
+	maze.addAllWalls();
+    counters = MazeCounters{};
+    depth = 0;
+    sliced = nullptr;
+    MAZE_TRACE_PHASE(generateBegin,maze.getWidth(),maze.getHeight(),mode);
+    if (mode == Mode::parallel)
     {
-        if (visit[x+1][y] == false)
-        {
-            direction.push_back(Direction::right);
-        }
+        generatingMazeParallel(maze);
     }
-
-    if (y-1 >= 0)
+    else if (mode == Mode::iterative)
     {
-        if (visit[x][y-1] == false)
-        {
-            direction.push_back(Direction::up);
-        }
+        visit.resize(maze.getWidth(), maze.getHeight());
+        generatingMazeIterative(0,0,maze);
     }
-
-    if (y+1 < maze.getHeight())
+    else
     {
-        if (visit[x][y+1] == false)
-        {
-            direction.push_back(Direction::down);
-        }
+        visit.resize(maze.getWidth(), maze.getHeight());
+        generatingMaze(0,0,maze);
     }
+    MAZE_TRACE_PHASE(generateEnd,maze.getWidth(),maze.getHeight(),mode);
+}
 
-    return direction;
+unsigned int myMazeGenerator::getDirections(int x,int y)
+{
+    return NeighbourMask::unvisited(visit,x,y);
 }
 
-void myMazeGenerator::check(int x,int y,vector<Direction> direction,Maze& maze)
+void myMazeGenerator::check(int x,int y,unsigned int directions,Maze& maze)
 {
-    int stop = direction.size()-1;
-    std::uniform_int_distribution<int> distribution{0, stop};
-    Direction changeDirection = direction[distribution(engine)];
+    Direction changeDirection = NeighbourMask::pick(directions,random);
+    counters.randomDraws++;
     int xc = x;
     int yc = y;
     switch (changeDirection)
@@ -74,7 +111,8 @@ void myMazeGenerator::check(int x,int y,vector<Direction> direction,Maze& maze)
     default:
         break;
     }
-    if (visit[xc][yc] == false && maze.wallExists(x,y,changeDirection))
+    counters.wallChecks++;
+    if (!visit.test(xc,yc) && maze.wallExists(x,y,changeDirection))
     {
         maze.removeWall(x,y,changeDirection);
         position = {xc,yc};
@@ -84,13 +122,301 @@ void myMazeGenerator::check(int x,int y,vector<Direction> direction,Maze& maze)
 
 void myMazeGenerator::generatingMaze(int x,int y,Maze& maze)
 {
-    visit[x][y] = true;
-    vector<Direction> direction = getDirections(x,y,maze);
-    while(direction.size()>0)
+    visit.set(x,y);
+    counters.cellsVisited++;
+    counters.reachedDepth(++depth);
+    MAZE_TRACE_STEP(generateVisit,x,y,0);
+    unsigned int directions = getDirections(x,y);
+    while(directions != 0)
     {
-        check(x,y,direction,maze);
+        check(x,y,directions,maze);
         generatingMaze(position[0],position[1],maze);
-        direction = getDirections(x,y,maze);
+        directions = getDirections(x,y);
     }
+    MAZE_TRACE_STEP(generateBacktrack,x,y,0);
+    counters.backtracks++;
+    depth--;
+    return;
+}
+
+// Same depth-first walk as generatingMaze, but the path back to the start
+// lives in a heap-allocated stack instead of on the call stack.  The stack
+// never holds more than one entry per cell.
+void myMazeGenerator::generatingMazeIterative(int x,int y,Maze& maze)
+{
+    startWalk(x,y);
+    continueWalk(maze,SIZE_MAX);
     return;
-}
\ No newline at end of file
+}
+
+void myMazeGenerator::startWalk(int x,int y)
+{
+    stack.clear();
+    visit.set(x,y);
+    counters.cellsVisited++;
+    MAZE_TRACE_STEP(generateVisit,x,y,0);
+    stack.push_back({x,y});
+    counters.reachedDepth(stack.size());
+}
+
+// Takes up to steps steps of the walk, each carving one cell or backing
+// up one, and returns whether the walk is over.
+bool myMazeGenerator::continueWalk(Maze& maze,size_t steps)
+{
+    for (; steps > 0 && stack.size() > 0; steps--)
+    {
+        int x = stack.back().first;
+        int y = stack.back().second;
+        unsigned int directions = getDirections(x,y);
+        if (directions != 0)
+        {
+            check(x,y,directions,maze);
+            visit.set(position[0],position[1]);
+            counters.cellsVisited++;
+            MAZE_TRACE_STEP(generateVisit,position[0],position[1],stack.size());
+            stack.push_back({position[0],position[1]});
+            counters.reachedDepth(stack.size());
+        }
+        else
+        {
+            MAZE_TRACE_STEP(generateBacktrack,x,y,stack.size());
+            stack.pop_back();
+            counters.backtracks++;
+        }
+    }
+    return stack.empty();
+}
+
+void myMazeGenerator::begin(Maze& maze)
+{
+    maze.addAllWalls();
+    counters = MazeCounters{};
+    MAZE_TRACE_PHASE(generateBegin,maze.getWidth(),maze.getHeight(),Mode::iterative);
+    visit.resize(maze.getWidth(), maze.getHeight());
+    startWalk(0,0);
+    sliced = &maze;
+}
+
+bool myMazeGenerator::step(size_t steps)
+{
+    if (sliced != nullptr && continueWalk(*sliced,steps))
+    {
+        MAZE_TRACE_PHASE(generateEnd,sliced->getWidth(),sliced->getHeight(),Mode::iterative);
+        sliced = nullptr;
+    }
+    return sliced == nullptr;
+}
+
+// The clock is read once per STEPS_PER_CLOCK_CHECK steps, a few
+// microseconds of work, so a deadline is overshot by about that much.
+bool myMazeGenerator::runUntil(chrono::steady_clock::time_point deadline)
+{
+    while (!step(STEPS_PER_CLOCK_CHECK))
+    {
+        if (chrono::steady_clock::now() >= deadline)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool myMazeGenerator::isFinished() const
+{
+    return sliced == nullptr;
+}
+
+// The workers never touch the Maze, since it isn't safe to write from
+// several threads.  Each one writes the walls it opens into its own tile's
+// bytes of carved[], and the walls are removed from the Maze afterwards.
+void myMazeGenerator::generatingMazeParallel(Maze& maze)
+{
+    int width = maze.getWidth();
+    int height = maze.getHeight();
+    carved.assign(static_cast<size_t>(width) * height, 0);
+
+    int tilesAcross = (width + tileSize - 1) / tileSize;
+    int tilesDown = (height + tileSize - 1) / tileSize;
+    int tiles = tilesAcross * tilesDown;
+
+    vector<uint64_t> seeds(tiles);
+    for (uint64_t& seed : seeds)
+    {
+        seed = random();
+    }
+
+    unsigned int workers = threadCount > 0 ? threadCount : thread::hardware_concurrency();
+    workers = max(1u, min(workers, static_cast<unsigned int>(tiles)));
+
+    counters.randomDraws += tiles;
+    vector<MazeCounters> tileCounters(tiles);
+    atomic<int> nextTile{0};
+    auto work = [&]()
+    {
+        for (int tile = nextTile++; tile < tiles; tile = nextTile++)
+        {
+            carveTile(tile,width,height,seeds[tile],tileCounters[tile]);
+        }
+    };
+
+    vector<thread> threads;
+    for (unsigned int i = 1; i < workers; i++)
+    {
+        threads.emplace_back(work);
+    }
+    work();
+    for (thread& t : threads)
+    {
+        t.join();
+    }
+    for (const MazeCounters& tileCounter : tileCounters)
+    {
+        counters += tileCounter;
+    }
+
+    joinTiles(width,height);
+
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            unsigned char open = carved[static_cast<size_t>(y) * width + x];
+            if (open & RIGHT_OPEN)
+            {
+                maze.removeWall(x,y,Direction::right);
+            }
+            if (open & DOWN_OPEN)
+            {
+                maze.removeWall(x,y,Direction::down);
+            }
+        }
+    }
+}
+
+// Runs the iterative depth-first carve confined to one tile, with its own
+// generator, visited grid and stack so workers share nothing but carved[].
+void myMazeGenerator::carveTile(int tile,int width,int height,uint64_t seed,MazeCounters& tileCounters)
+{
+    int tilesAcross = (width + tileSize - 1) / tileSize;
+    int left = (tile % tilesAcross) * tileSize;
+    int top = (tile / tilesAcross) * tileSize;
+    int tileWidth = min(tileSize, width - left);
+    int tileHeight = min(tileSize, height - top);
+
+    MazeRandom tileRandom{seed};
+    BitGrid tileVisit{tileWidth, tileHeight, visit.getLayout()};
+    vector<pair<int,int>> tileStack;
+
+    tileVisit.set(0,0);
+    tileCounters.cellsVisited++;
+    tileStack.push_back({0,0});
+    tileCounters.reachedDepth(tileStack.size());
+    while(tileStack.size()>0)
+    {
+        int x = tileStack.back().first;
+        int y = tileStack.back().second;
+
+        unsigned int directions = NeighbourMask::unvisited(tileVisit,x,y);
+        if (directions == 0)
+        {
+            tileStack.pop_back();
+            tileCounters.backtracks++;
+            continue;
+        }
+
+        int xc = x;
+        int yc = y;
+        tileCounters.randomDraws++;
+        switch (NeighbourMask::pick(directions,tileRandom))
+        {
+        case Direction::up:
+            yc--;
+            carved[static_cast<size_t>(top+yc) * width + left+xc] |= DOWN_OPEN;
+            break;
+        case Direction::down:
+            yc++;
+            carved[static_cast<size_t>(top+y) * width + left+x] |= DOWN_OPEN;
+            break;
+        case Direction::left:
+            xc--;
+            carved[static_cast<size_t>(top+yc) * width + left+xc] |= RIGHT_OPEN;
+            break;
+        case Direction::right:
+            xc++;
+            carved[static_cast<size_t>(top+y) * width + left+x] |= RIGHT_OPEN;
+            break;
+        }
+        tileVisit.set(xc,yc);
+        tileCounters.cellsVisited++;
+        tileStack.push_back({xc,yc});
+        tileCounters.reachedDepth(tileStack.size());
+    }
+}
+
+// Treats every tile as one node and grows a random spanning tree over
+// the grid of tiles; each tree edge opens one randomly chosen wall on the
+// border the two tiles share.
+void myMazeGenerator::joinTiles(int width,int height)
+{
+    int tilesAcross = (width + tileSize - 1) / tileSize;
+    int tilesDown = (height + tileSize - 1) / tileSize;
+
+    BitGrid tileVisit{tilesAcross, tilesDown};
+    vector<pair<int,int>> tileStack;
+    tileVisit.set(0,0);
+    tileStack.push_back({0,0});
+    while(tileStack.size()>0)
+    {
+        int tx = tileStack.back().first;
+        int ty = tileStack.back().second;
+
+        unsigned int directions = NeighbourMask::unvisited(tileVisit,tx,ty);
+        if (directions == 0)
+        {
+            tileStack.pop_back();
+            continue;
+        }
+
+        Direction changeDirection = NeighbourMask::pick(directions,random);
+        // The direction here and the door's place along the border below.
+        counters.randomDraws += 2;
+        int txc = tx;
+        int tyc = ty;
+        switch (changeDirection)
+        {
+        case Direction::up:
+            tyc--;
+            break;
+        case Direction::down:
+            tyc++;
+            break;
+        case Direction::left:
+            txc--;
+            break;
+        case Direction::right:
+            txc++;
+            break;
+        }
+
+        // The wall is opened from the upper or left tile of the pair.
+        int upperX = min(tx, txc);
+        int upperY = min(ty, tyc);
+        if (changeDirection == Direction::left || changeDirection == Direction::right)
+        {
+            int x = upperX * tileSize + tileSize - 1;
+            int top = upperY * tileSize;
+            int along = top + random.below(min(tileSize, height - top));
+            carved[static_cast<size_t>(along) * width + x] |= RIGHT_OPEN;
+        }
+        else
+        {
+            int y = upperY * tileSize + tileSize - 1;
+            int left = upperX * tileSize;
+            int along = left + random.below(min(tileSize, width - left));
+            carved[static_cast<size_t>(y) * width + along] |= DOWN_OPEN;
+        }
+
+        tileVisit.set(txc,tyc);
+        tileStack.push_back({txc,tyc});
+    }
+}
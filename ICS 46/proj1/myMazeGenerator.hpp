@@ -4,23 +4,99 @@
 #include "MazeGenerator.hpp"
 #include "Maze.hpp"
 #include "Direction.hpp"
-#include <random>
+#include "MazeRandom.hpp"
+#include "BitGrid.hpp"
+#include "MazeCounters.hpp"
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <cstdint>
 #include <vector>
 using namespace std;
 
 class myMazeGenerator: public MazeGenerator
 {
 public:
-	vector<Direction> getDirections(int x,int y,Maze& maze);
-	void check(int x,int y,vector<Direction> direction,Maze& maze);
+    // recursive carves the maze with one call per cell, iterative keeps the
+    // same walk on a heap-allocated stack so large mazes don't overflow the
+    // call stack.  parallel splits the grid into square tiles, carves each
+    // tile on a worker thread and then links the tiles with a random
+    // spanning tree, which is still a perfect maze.  The factory makes
+    // iterative generators; recursive is kept only for comparison and has
+    // to be asked for.
+    enum class Mode { recursive, iterative, parallel };
+
+    static constexpr int DEFAULT_TILE_SIZE = 256;
+
+    myMazeGenerator(Mode mode = Mode::iterative);
+
+    // getDirections() returns the unvisited neighbours as a NeighbourMask
+    // and check() carves towards a random one of them.
+	unsigned int getDirections(int x,int y);
+	void check(int x,int y,unsigned int directions,Maze& maze);
 	void generateMaze(Maze& maze) override;
 	void generatingMaze(int x,int y,Maze& maze);
+    void generatingMazeIterative(int x,int y,Maze& maze);
+    void generatingMazeParallel(Maze& maze);
+
+    Mode getMode() const;
+    void setMode(Mode mode);
+
+    // Used by Mode::parallel only.  A thread count of 0 means one thread
+    // per hardware core.
+    unsigned int getThreadCount() const;
+    void setThreadCount(unsigned int threadCount);
+    void setTileSize(int tileSize);
+
+    // setSeed() makes the following runs repeat exactly: the same seed
+    // and the same maze size give the same maze.
+    void setSeed(uint64_t seed);
+
+    // The cell order of the visited grids; see BitGrid::Layout.
+    BitGrid::Layout getGridLayout() const;
+    void setGridLayout(BitGrid::Layout layout);
+
+    // Time-sliced generation for callers that can't block, like a UI
+    // thread with a frame to draw.  begin() clears maze and starts the
+    // iterative walk on it; each step() then takes at most that many steps
+    // (a step carves a cell or backs up one) and runUntil() keeps going
+    // until the deadline.  Both return true once the maze is finished.
+    // The walk's stack stays in the generator between calls, maze must
+    // outlive the run, and the result is the same maze the iterative mode
+    // makes from the same seed.  generateMaze() abandons a sliced run.
+    void begin(Maze& maze);
+    bool step(size_t steps);
+    bool runUntil(chrono::steady_clock::time_point deadline);
+    bool isFinished() const;
+
+    // Counts for the last generateMaze().  In parallel mode the tiles'
+    // counts are added together and the depth is the deepest tile's.
+    const MazeCounters& getCounters() const;
+
+private:
+    // Bits of carved[], one byte per cell in row-major order.
+    static constexpr unsigned char RIGHT_OPEN = 1;
+    static constexpr unsigned char DOWN_OPEN = 2;
+
+    static constexpr size_t STEPS_PER_CLOCK_CHECK = 4096;
+
+    void startWalk(int x,int y);
+    bool continueWalk(Maze& maze,size_t steps);
+    void carveTile(int tile,int width,int height,uint64_t seed,MazeCounters& tileCounters);
+    void joinTiles(int width,int height);
 
 private:
-    vector<vector<bool>> visit;
+    Mode mode;
+    unsigned int threadCount = 0;
+    int tileSize = DEFAULT_TILE_SIZE;
+    vector<unsigned char> carved;
+    BitGrid visit;
+    vector<pair<int,int>> stack;
 	vector<int> position = {0,0};
-    std::random_device device;
-    std::default_random_engine engine{device()};
+    MazeRandom random;
+    MazeCounters counters;
+    size_t depth = 0;
+    Maze* sliced = nullptr;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,136 @@
+// myMazeGenerator_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks that every mode of myMazeGenerator makes perfect mazes.
+
+#include <gtest/gtest.h>
+#include "myMazeGenerator.hpp"
+#include "MazeSanityChecks.hpp"
+#include <chrono>
+
+using namespace MazeSanityChecks;
+
+
+TEST(myMazeGenerator_SanityCheckTests, recursiveAndIterativeMakePerfectMazes)
+{
+    for (myMazeGenerator::Mode mode : {myMazeGenerator::Mode::recursive, myMazeGenerator::Mode::iterative})
+    {
+        myMazeGenerator generator{mode};
+        EXPECT_TRUE(isPerfect(*generated(generator)));
+        EXPECT_TRUE(isPerfect(*generated(generator, 1, 1)));
+        EXPECT_TRUE(isPerfect(*generated(generator, 50, 2)));
+    }
+}
+
+
+TEST(myMazeGenerator_SanityCheckTests, defaultModeIsIterative)
+{
+    EXPECT_EQ(myMazeGenerator::Mode::iterative, myMazeGenerator{}.getMode());
+}
+
+
+// A million cells deep is far past what the recursive mode's call stack
+// survives; the iterative mode only needs heap.
+TEST(myMazeGenerator_SanityCheckTests, iterativeHandlesLargeMazes)
+{
+    myMazeGenerator generator{myMazeGenerator::Mode::iterative};
+    EXPECT_TRUE(isPerfect(*generated(generator, 1000, 1000)));
+}
+
+
+TEST(myMazeGenerator_SanityCheckTests, parallelMakesPerfectMazes)
+{
+    myMazeGenerator generator{myMazeGenerator::Mode::parallel};
+    generator.setSeed(1);
+    generator.setThreadCount(3);
+    generator.setTileSize(8);
+    EXPECT_TRUE(isPerfect(*generated(generator)));
+    EXPECT_TRUE(isPerfect(*generated(generator, 1, 1)));
+    EXPECT_TRUE(isPerfect(*generated(generator, 50, 2)));
+}
+
+
+// Each tile draws from its own seed, so the thread count only changes
+// who carves it.
+TEST(myMazeGenerator_SanityCheckTests, parallelIsTheSameForAnyThreadCount)
+{
+    myMazeGenerator generator{myMazeGenerator::Mode::parallel};
+    generator.setTileSize(8);
+    generator.setSeed(7);
+    generator.setThreadCount(1);
+    std::unique_ptr<Maze> single = generated(generator);
+    generator.setSeed(7);
+    generator.setThreadCount(4);
+    EXPECT_TRUE(sameWalls(*single, *generated(generator)));
+}
+
+
+TEST(myMazeGenerator_SanityCheckTests, sameSeedMakesTheSameMaze)
+{
+    for (myMazeGenerator::Mode mode : {myMazeGenerator::Mode::recursive, myMazeGenerator::Mode::iterative})
+    {
+        myMazeGenerator generator{mode};
+        generator.setSeed(17);
+        std::unique_ptr<Maze> first = generated(generator);
+        generator.setSeed(17);
+        EXPECT_TRUE(sameWalls(*first, *generated(generator)));
+        generator.setSeed(18);
+        EXPECT_FALSE(sameWalls(*first, *generated(generator)));
+    }
+}
+
+
+TEST(myMazeGenerator_SanityCheckTests, zOrderGridsMakeTheSameMazes)
+{
+    myMazeGenerator generator;
+    generator.setSeed(2);
+    std::unique_ptr<Maze> rowMajor = generated(generator);
+    generator.setGridLayout(BitGrid::Layout::morton);
+    generator.setSeed(2);
+    std::unique_ptr<Maze> morton = generated(generator);
+    EXPECT_TRUE(isPerfect(*morton));
+    EXPECT_TRUE(sameWalls(*rowMajor, *morton));
+    EXPECT_TRUE(isPerfect(*generated(generator, 300, 3)));
+}
+
+
+TEST(myMazeGenerator_SanityCheckTests, timeSlicedGenerationMatchesIterative)
+{
+    myMazeGenerator generator;
+    generator.setSeed(3);
+    std::unique_ptr<Maze> whole = generated(generator);
+
+    std::unique_ptr<Maze> sliced = MazeFactory{}.createMaze(WIDTH, HEIGHT);
+    generator.setSeed(3);
+    generator.begin(*sliced);
+    int slices = 0;
+    while (!generator.step(10))
+    {
+        slices++;
+    }
+    EXPECT_TRUE(generator.isFinished());
+    EXPECT_GT(slices, 1);
+    EXPECT_TRUE(sameWalls(*whole, *sliced));
+}
+
+
+TEST(myMazeGenerator_SanityCheckTests, runUntilStopsAtTheDeadline)
+{
+    // runUntil() takes a batch of steps between looks at the clock, so
+    // the maze needs more cells than one batch carves.
+    myMazeGenerator generator;
+    generator.setSeed(27);
+    std::unique_ptr<Maze> sliced = MazeFactory{}.createMaze(300, 300);
+    generator.begin(*sliced);
+    EXPECT_FALSE(generator.runUntil(std::chrono::steady_clock::now() - std::chrono::seconds{1}));
+    EXPECT_FALSE(generator.isFinished());
+    EXPECT_TRUE(generator.runUntil(std::chrono::steady_clock::now() + std::chrono::hours{1}));
+    EXPECT_TRUE(isPerfect(*sliced));
+
+    // generateMaze() in the middle of a sliced run abandons it.
+    generator.begin(*sliced);
+    generator.step(5);
+    EXPECT_TRUE(isPerfect(*generated(generator)));
+}
@@ -1,63 +1,84 @@
 #include "myMazeSolver.hpp"
-#include <iostream>
+#include "MazeTrace.hpp"
+#include "NeighbourMask.hpp"
+#include "MazeSearch.hpp"
 #include <ics46/factory/DynamicFactory.hpp>
 using namespace std;
 
 ICS46_DYNAMIC_FACTORY_REGISTER(MazeSolver, myMazeSolver, "Richard's MazeSolver(Required)");
 
+myMazeSolver::myMazeSolver(Mode mode)
+    : mode{mode}
+{
+}
+
+myMazeSolver::Mode myMazeSolver::getMode() const
+{
+    return mode;
+}
+
+void myMazeSolver::setMode(Mode mode)
+{
+    this->mode = mode;
+}
+
 void myMazeSolver::solveMaze(const Maze& maze, MazeSolution& mazeSolution)
 {
     mazeSolution.restart();
     pair<int,int> start = mazeSolution.getStartingCell();
-    visit.resize(mazeSolution.getWidth(), vector<bool>(mazeSolution.getHeight(), false));
+    visit.resize(mazeSolution.getWidth(), mazeSolution.getHeight());
+    counters = MazeCounters{};
+    depth = 0;
     int x = get<0>(start);
     int y = get<1>(start);
-    solvingMaze(x,y,maze,mazeSolution);
-}
-
-vector<Direction> myMazeSolver::checkDirections(int x,int y,const Maze& maze)
-{
-    vector<Direction> direction;
-    if (x-1 >= 0)
+    MAZE_TRACE_PHASE(solveBegin,x,y,0);
+    if (mode == Mode::replay)
     {
-        if (visit[x-1][y] == false && !(maze.wallExists(x,y,Direction::left)))
-        {
-            direction.push_back(Direction::left);
-        }
+        solvingMazeReplay(x,y,maze,mazeSolution);
     }
-
-    if (x+1 < maze.getWidth())
+    else
     {
-        if (visit[x+1][y] == false && !(maze.wallExists(x,y,Direction::right)))
-        {
-            direction.push_back(Direction::right);
-        }
+        solvingMaze(x,y,maze,mazeSolution);
     }
+    MAZE_TRACE_PHASE(solveEnd,x,y,mazeSolution.getMovements().size());
+}
 
-    if (y-1 >= 0)
-    {
-        if (visit[x][y-1] == false && !(maze.wallExists(x,y,Direction::up)))
-        {
-            direction.push_back(Direction::up);
-        }
-    }
+void myMazeSolver::setSeed(uint64_t seed)
+{
+    random.seed(seed);
+}
 
-    if (y+1 < maze.getHeight())
-    {
-        if (visit[x][y+1] == false && !(maze.wallExists(x,y,Direction::down)))
-        {
-            direction.push_back(Direction::down);
-        }
-    }
+void myMazeSolver::setCancel(const atomic<bool>* cancel)
+{
+    this->cancel = cancel;
+}
+
+BitGrid::Layout myMazeSolver::getGridLayout() const
+{
+    return visit.getLayout();
+}
+
+void myMazeSolver::setGridLayout(BitGrid::Layout layout)
+{
+    visit.setLayout(layout);
+}
 
-    return direction;
+const MazeCounters& myMazeSolver::getCounters() const
+{
+    return counters;
 }
 
-void myMazeSolver::MovingCell(int x,int y,vector<Direction> direction,const Maze& maze,MazeSolution& mazeSolution)
+unsigned int myMazeSolver::checkDirections(int x,int y,const Maze& maze)
 {
-    int stop = direction.size()-1;
-    std::uniform_int_distribution<int> distribution{0, stop};
-    Direction pointingDirection = direction[distribution(engine)];
+    unsigned int unvisited = NeighbourMask::unvisited(visit,x,y);
+    counters.wallChecks += NeighbourMask::count(unvisited);
+    return NeighbourMask::open(maze,x,y,unvisited);
+}
+
+void myMazeSolver::MovingCell(int x,int y,unsigned int directions,const Maze& maze,MazeSolution& mazeSolution)
+{
+    Direction pointingDirection = NeighbourMask::pick(directions,random);
+    counters.randomDraws++;
     int xc = x;
     int yc = y;
     switch (pointingDirection)
@@ -78,36 +99,107 @@ void myMazeSolver::MovingCell(int x,int y,vector<Direction> direction,const Maze
     default:
         break;
     }
-    if (visit[xc][yc] == false && !maze.wallExists(x,y,pointingDirection))
+    counters.wallChecks++;
+    if (!visit.test(xc,yc) && !maze.wallExists(x,y,pointingDirection))
     {
         position = {xc,yc};
         mazeSolution.extend(pointingDirection);
+        counters.reachedDepth(++depth);
     }
 	return;
 }
 
 void myMazeSolver::solvingMaze(int x,int y,const Maze& maze,MazeSolution& mazeSolution)
 {
-    visit[x][y] = true;
-    vector<Direction> direction = checkDirections(x,y,maze);
+    if (!visit.testAndSet(x,y))
+    {
+        counters.cellsVisited++;
+    }
+    unsigned int directions = checkDirections(x,y,maze);
     while(mazeSolution.getCurrentCell()!=mazeSolution.getEndingCell())
     {
-        cout <<x<<" "<<y<<" "<<direction.size()<<endl;
-        if (direction.size()>0)
+        MAZE_TRACE_STEP(solveStep,x,y,NeighbourMask::count(directions));
+        if (directions != 0)
         {
-            MovingCell(x,y,direction,maze,mazeSolution);
+            MovingCell(x,y,directions,maze,mazeSolution);
             x = position[0];
             y = position[1];
         }
         else
         {
+            MAZE_TRACE_STEP(solveBackUp,x,y,0);
             mazeSolution.backUp();
+            counters.backtracks++;
+            depth--;
             x = get<0>(mazeSolution.getCurrentCell());
             y = get<1>(mazeSolution.getCurrentCell());
             position = {x,y};
         }
-        visit[x][y] = true;
-        direction = checkDirections(x,y,maze);
+        if (!visit.testAndSet(x,y))
+        {
+            counters.cellsVisited++;
+        }
+        directions = checkDirections(x,y,maze);
     }
     return;
 }
+
+// The walk of solvingMaze, with moves[] standing in for the MazeSolution:
+// a dead end pops a move instead of calling backUp(), and the cell is
+// tracked here instead of asked for with getCurrentCell().  Only the
+// moves left at the end are written out.  If the ending cell can't be
+// reached the MazeSolution is left at its start.
+void myMazeSolver::solvingMazeReplay(int x,int y,const Maze& maze,MazeSolution& mazeSolution)
+{
+    if (walk(x,y,mazeSolution.getEndingCell(),maze,moves))
+    {
+        MazeSearch::writePath(moves,mazeSolution);
+    }
+}
+
+bool myMazeSolver::findPath(const Maze& maze,pair<int,int> start,pair<int,int> end,vector<Direction>& path)
+{
+    visit.resize(maze.getWidth(), maze.getHeight());
+    counters = MazeCounters{};
+    return walk(start.first,start.second,end,maze,path);
+}
+
+bool myMazeSolver::walk(int x,int y,pair<int,int> end,const Maze& maze,vector<Direction>& path)
+{
+    path.clear();
+    if (!visit.testAndSet(x,y))
+    {
+        counters.cellsVisited++;
+    }
+    for (size_t steps = 1; x != end.first || y != end.second; steps++)
+    {
+        if (steps % MazeSearch::CANCEL_POLL_INTERVAL == 0 && MazeSearch::cancelled(cancel))
+        {
+            return false;
+        }
+        unsigned int directions = checkDirections(x,y,maze);
+        MAZE_TRACE_STEP(solveStep,x,y,NeighbourMask::count(directions));
+        if (directions != 0)
+        {
+            Direction direction = NeighbourMask::pick(directions,random);
+            counters.randomDraws++;
+            MazeSearch::step(direction,x,y);
+            path.push_back(direction);
+            counters.reachedDepth(path.size());
+            visit.set(x,y);
+            counters.cellsVisited++;
+        }
+        else if (path.size() > 0)
+        {
+            MAZE_TRACE_STEP(solveBackUp,x,y,0);
+            MazeSearch::step(MazeSearch::opposite(path.back()),x,y);
+            path.pop_back();
+            counters.backtracks++;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
@@ -4,23 +4,68 @@
 #include "MazeSolver.hpp"
 #include "MazeSolution.hpp"
 #include "Direction.hpp"
+#include "MazeRandom.hpp"
+#include "BitGrid.hpp"
 #include "Maze.hpp"
-#include <random>
+#include "MazeCounters.hpp"
+#include <atomic>
+#include <cstdint>
+#include <utility>
 #include <vector>
 using namespace std;
 
 class myMazeSolver: public MazeSolver
 {
 public:
-    vector<Direction> checkDirections(int x,int y,const Maze& maze);
+    // stepwise drives the MazeSolution through the whole walk, dead ends
+    // and backUp() calls included, so a viewer can watch the search.
+    // replay walks on its own stack of moves and then only extend()s the
+    // MazeSolution along the finished route.  Both pick the same
+    // directions, so with the same seed they find the same route.
+    enum class Mode { stepwise, replay };
+
+    myMazeSolver(Mode mode = Mode::stepwise);
+
+    Mode getMode() const;
+    void setMode(Mode mode);
+
+    // checkDirections() returns the open, unvisited neighbours as a
+    // NeighbourMask; MovingCell() steps to a random one of them.
+    unsigned int checkDirections(int x,int y,const Maze& maze);
     void solvingMaze(int x,int y,const Maze& maze,MazeSolution& mazeSolution);
     void solveMaze(const Maze& maze, MazeSolution& mazeSolution) override;
-    void MovingCell(int x,int y,vector<Direction> direction,const Maze& maze,MazeSolution& mazeSolution);
+    void MovingCell(int x,int y,unsigned int directions,const Maze& maze,MazeSolution& mazeSolution);
+    void solvingMazeReplay(int x,int y,const Maze& maze,MazeSolution& mazeSolution);
+
+    // findPath() runs the replay walk into path without a MazeSolution and
+    // returns false if end can't be reached or the search was cancelled.
+    bool findPath(const Maze& maze,pair<int,int> start,pair<int,int> end,vector<Direction>& path);
+
+    // setSeed() makes the following runs pick the same directions.
+    void setSeed(uint64_t seed);
+
+    // setCancel() makes findPath() give up once *cancel turns true; pass
+    // nullptr to stop watching.
+    void setCancel(const atomic<bool>* cancel);
+
+    // The cell order of the visited grid; see BitGrid::Layout.
+    BitGrid::Layout getGridLayout() const;
+    void setGridLayout(BitGrid::Layout layout);
+
+    // Counts for the last solveMaze().
+    const MazeCounters& getCounters() const;
+private:
+    bool walk(int x,int y,pair<int,int> end,const Maze& maze,vector<Direction>& path);
+
 private:
-    vector<vector<bool>> visit;
+    Mode mode;
+    const atomic<bool>* cancel = nullptr;
+    BitGrid visit;
+    vector<Direction> moves;
 	vector<int> position = {0,0};
-    std::random_device device;
-    std::default_random_engine engine{device()};
+    MazeRandom random;
+    MazeCounters counters;
+    size_t depth = 0;
 };
 
 
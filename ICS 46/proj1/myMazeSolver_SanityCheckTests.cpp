@@ -0,0 +1,87 @@
+// myMazeSolver_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks that the stepwise and replay modes both solve the maze and, from
+// the same seed, end up with the same route.
+
+#include <gtest/gtest.h>
+#include "myMazeSolver.hpp"
+#include "MazeSolutionFactory.hpp"
+#include "MazeSanityChecks.hpp"
+#include <atomic>
+#include <vector>
+
+using namespace MazeSanityChecks;
+
+
+TEST(myMazeSolver_SanityCheckTests, bothModesSolvePerfectMazes)
+{
+    for (myMazeSolver::Mode mode : {myMazeSolver::Mode::stepwise, myMazeSolver::Mode::replay})
+    {
+        myMazeSolver solver{mode};
+        for (uint64_t seed : {5, 6})
+        {
+            std::unique_ptr<Maze> maze = perfectMaze(seed);
+            std::unique_ptr<MazeSolution> solution = MazeSolutionFactory{}.createMazeSolution(WIDTH, HEIGHT);
+            solver.solveMaze(*maze, *solution);
+            EXPECT_TRUE(solvedCorrectly(*maze, *solution)) << "seed " << seed;
+        }
+    }
+}
+
+
+TEST(myMazeSolver_SanityCheckTests, replayFindsTheStepwiseRoute)
+{
+    std::unique_ptr<Maze> maze = bandedMaze();
+    std::unique_ptr<MazeSolution> stepwise = MazeSolutionFactory{}.createMazeSolution(WIDTH, HEIGHT);
+    std::unique_ptr<MazeSolution> replayed = MazeSolutionFactory{}.createMazeSolution(WIDTH, HEIGHT);
+    myMazeSolver solver;
+    solver.setSeed(24);
+    solver.solveMaze(*maze, *stepwise);
+    solver.setMode(myMazeSolver::Mode::replay);
+    solver.setSeed(24);
+    solver.solveMaze(*maze, *replayed);
+    EXPECT_TRUE(solvedCorrectly(*maze, *replayed));
+    EXPECT_EQ(stepwise->getMovements(), replayed->getMovements());
+
+    std::vector<Direction> path;
+    solver.setSeed(24);
+    EXPECT_TRUE(solver.findPath(*maze, {0, 0}, {WIDTH-1, HEIGHT-1}, path));
+    EXPECT_EQ(replayed->getMovements(), path);
+}
+
+
+TEST(myMazeSolver_SanityCheckTests, findPathGivesUpWhenCancelledOrStuck)
+{
+    std::unique_ptr<Maze> maze = MazeFactory{}.createMaze(200, 200);
+    maze->removeAllWalls();
+    std::atomic<bool> cancel{true};
+    myMazeSolver solver;
+    solver.setSeed(25);
+    solver.setCancel(&cancel);
+    std::vector<Direction> path;
+    EXPECT_FALSE(solver.findPath(*maze, {0, 0}, {199, 199}, path));
+    solver.setCancel(nullptr);
+    EXPECT_TRUE(solver.findPath(*maze, {0, 0}, {199, 199}, path));
+
+    std::unique_ptr<Maze> walled = MazeFactory{}.createMaze(4, 4);
+    walled->addAllWalls();
+    EXPECT_FALSE(solver.findPath(*walled, {0, 0}, {3, 3}, path));
+}
+
+
+TEST(myMazeSolver_SanityCheckTests, zOrderGridsFindTheSameRoute)
+{
+    std::unique_ptr<Maze> maze = bandedMaze();
+    std::vector<Direction> rowMajor;
+    std::vector<Direction> morton;
+    myMazeSolver solver;
+    solver.setSeed(26);
+    ASSERT_TRUE(solver.findPath(*maze, {0, 0}, {WIDTH-1, HEIGHT-1}, rowMajor));
+    solver.setGridLayout(BitGrid::Layout::morton);
+    solver.setSeed(26);
+    ASSERT_TRUE(solver.findPath(*maze, {0, 0}, {WIDTH-1, HEIGHT-1}, morton));
+    EXPECT_EQ(rowMajor, morton);
+}
@@ -0,0 +1,130 @@
+#include "myPortfolioMazeSolver.hpp"
+#include "MazeSearch.hpp"
+#include "myMazeSolver.hpp"
+#include "myBFSMazeSolver.hpp"
+#include "myAStarMazeSolver.hpp"
+#include "myWallFollowerMazeSolver.hpp"
+#include "myTremauxMazeSolver.hpp"
+#include <ics46/factory/DynamicFactory.hpp>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+using namespace std;
+
+ICS46_DYNAMIC_FACTORY_REGISTER(MazeSolver, myPortfolioMazeSolver, "Richard's Portfolio MazeSolver (racing threads)");
+
+namespace
+{
+    // Wraps a solver with findPath() and setCancel(), kept alive by the
+    // strategy so its buffers are reused from race to race.
+    template <typename Solver>
+    myPortfolioMazeSolver::Strategy strategyFor(shared_ptr<Solver> solver)
+    {
+        return [solver](const Maze& maze, pair<int,int> start, pair<int,int> end,
+                        vector<Direction>& path, const atomic<bool>* cancel)
+        {
+            solver->setCancel(cancel);
+            bool found = solver->findPath(maze,start,end,path);
+            solver->setCancel(nullptr);
+            return found;
+        };
+    }
+}
+
+myPortfolioMazeSolver::myPortfolioMazeSolver()
+{
+    addStrategy("dfs", strategyFor(make_shared<myMazeSolver>(myMazeSolver::Mode::replay)));
+    addStrategy("bfs", strategyFor(make_shared<myBFSMazeSolver>()));
+    addStrategy("astar", strategyFor(make_shared<myAStarMazeSolver>()));
+    addStrategy("wallfollower", strategyFor(make_shared<myWallFollowerMazeSolver>()));
+    addStrategy("tremaux", strategyFor(make_shared<myTremauxMazeSolver>()));
+}
+
+void myPortfolioMazeSolver::clearStrategies()
+{
+    strategies.clear();
+}
+
+void myPortfolioMazeSolver::addStrategy(const string& name,Strategy strategy)
+{
+    strategies.push_back({name, strategy});
+}
+
+const string& myPortfolioMazeSolver::getWinner() const
+{
+    return winner;
+}
+
+void myPortfolioMazeSolver::solveMaze(const Maze& maze, MazeSolution& mazeSolution)
+{
+    if (findPath(maze,mazeSolution.getStartingCell(),mazeSolution.getEndingCell(),path))
+    {
+        MazeSearch::writePath(path,mazeSolution);
+    }
+}
+
+// Each strategy writes into its own results[] entry, so the threads share
+// only the two atomics, and the error slot if something throws.  The
+// winner is whoever first swaps its index into winnerIndex; the same store
+// tells the rest to stop.
+bool myPortfolioMazeSolver::findPath(const Maze& maze,pair<int,int> start,pair<int,int> end,vector<Direction>& path)
+{
+    winner.clear();
+    results.resize(strategies.size());
+    atomic<bool> finished{false};
+    atomic<int> winnerIndex{-1};
+    exception_ptr error;
+    mutex errorLock;
+
+    auto race = [&](int i)
+    {
+        try
+        {
+            if (strategies[i].second(maze,start,end,results[i],&finished))
+            {
+                int none = -1;
+                if (winnerIndex.compare_exchange_strong(none, i))
+                {
+                    finished.store(true, memory_order_relaxed);
+                }
+            }
+        }
+        catch (...)
+        {
+            lock_guard<mutex> guard{errorLock};
+            if (!error)
+            {
+                error = current_exception();
+            }
+            finished.store(true, memory_order_relaxed);
+        }
+    };
+
+    vector<thread> threads;
+    for (size_t i = 1; i < strategies.size(); i++)
+    {
+        threads.emplace_back(race, static_cast<int>(i));
+    }
+    if (strategies.size() > 0)
+    {
+        race(0);
+    }
+    for (thread& t : threads)
+    {
+        t.join();
+    }
+    if (error)
+    {
+        rethrow_exception(error);
+    }
+
+    int won = winnerIndex.load();
+    if (won < 0)
+    {
+        return false;
+    }
+    winner = strategies[won].first;
+    path.swap(results[won]);
+    return true;
+}
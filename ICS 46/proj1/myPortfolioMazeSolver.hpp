@@ -0,0 +1,55 @@
+#ifndef MYPORTFOLIOMAZESOLVER_HPP
+#define MYPORTFOLIOMAZESOLVER_HPP
+
+#include "MazeSolver.hpp"
+#include "MazeSolution.hpp"
+#include "Direction.hpp"
+#include "Maze.hpp"
+#include <atomic>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// Races several solvers against each other, one thread each, on the same
+// read-only Maze.  The first to find a route wins; it raises a shared flag
+// that the others poll, so they stop within a few thousand cells instead
+// of running to the end.  Which strategy wins on which mazes is what to
+// look at when choosing a default solver.
+class myPortfolioMazeSolver: public MazeSolver
+{
+public:
+    // A Strategy finds a route from start to end, or returns false when
+    // there is none or once *cancel turns true.  It is only ever run by
+    // one thread at a time.
+    using Strategy = function<bool(const Maze& maze, pair<int,int> start, pair<int,int> end,
+                                   vector<Direction>& path, const atomic<bool>* cancel)>;
+
+    // Starts with depth-first ("dfs"), breadth-first ("bfs"), A*
+    // ("astar"), the wall follower ("wallfollower") and Trémaux
+    // ("tremaux").
+    myPortfolioMazeSolver();
+
+    // The strategies raced, in order; addStrategy() adds one more.
+    void clearStrategies();
+    void addStrategy(const string& name,Strategy strategy);
+
+    void solveMaze(const Maze& maze, MazeSolution& mazeSolution) override;
+
+    // If a strategy throws, the race is called off and the first exception
+    // thrown is rethrown from findPath() once every thread has stopped.
+    bool findPath(const Maze& maze,pair<int,int> start,pair<int,int> end,vector<Direction>& path);
+
+    // The name of the strategy that won the last race, or "" if none
+    // found a route.
+    const string& getWinner() const;
+
+private:
+    vector<pair<string,Strategy>> strategies;
+    vector<vector<Direction>> results;
+    vector<Direction> path;
+    string winner;
+};
+
+#endif
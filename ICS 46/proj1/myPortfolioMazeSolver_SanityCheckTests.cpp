@@ -0,0 +1,117 @@
+// myPortfolioMazeSolver_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks that the first strategy to finish wins and cancels the rest, and
+// that a strategy throwing is reported to the caller instead of taking
+// the program down.  Run these under ThreadSanitizer too.
+
+#include <gtest/gtest.h>
+#include "myPortfolioMazeSolver.hpp"
+#include "myBFSMazeSolver.hpp"
+#include "MazeSolutionFactory.hpp"
+#include "MazeSanityChecks.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace MazeSanityChecks;
+
+
+namespace
+{
+    bool breadthFirst(const Maze& maze, std::pair<int,int> start, std::pair<int,int> end,
+                      std::vector<Direction>& path, const std::atomic<bool>* cancel)
+    {
+        myBFSMazeSolver solver;
+        solver.setCancel(cancel);
+        return solver.findPath(maze, start, end, path);
+    }
+}
+
+
+TEST(myPortfolioMazeSolver_SanityCheckTests, solvesPerfectMazes)
+{
+    myPortfolioMazeSolver solver;
+    for (uint64_t seed : {5, 6})
+    {
+        std::unique_ptr<Maze> maze = perfectMaze(seed);
+        std::unique_ptr<MazeSolution> solution = MazeSolutionFactory{}.createMazeSolution(WIDTH, HEIGHT);
+        solver.solveMaze(*maze, *solution);
+        EXPECT_TRUE(solvedCorrectly(*maze, *solution)) << "seed " << seed;
+        EXPECT_NE("", solver.getWinner());
+    }
+}
+
+
+TEST(myPortfolioMazeSolver_SanityCheckTests, cancelsTheLosers)
+{
+    std::unique_ptr<Maze> maze = perfectMaze(9);
+    std::atomic<bool> loserStopped{false};
+
+    myPortfolioMazeSolver portfolio;
+    portfolio.clearStrategies();
+    portfolio.addStrategy("never", [&](const Maze&, std::pair<int,int>, std::pair<int,int>,
+                                       std::vector<Direction>&, const std::atomic<bool>* cancel)
+    {
+        while (!cancel->load())
+        {
+        }
+        loserStopped = true;
+        return false;
+    });
+    portfolio.addStrategy("bfs", breadthFirst);
+
+    std::vector<Direction> path;
+    ASSERT_TRUE(portfolio.findPath(*maze, {0, 0}, {WIDTH-1, HEIGHT-1}, path));
+    EXPECT_EQ("bfs", portfolio.getWinner());
+    EXPECT_TRUE(isRoute(*maze, {0, 0}, {WIDTH-1, HEIGHT-1}, path));
+    EXPECT_TRUE(loserStopped);
+}
+
+
+TEST(myPortfolioMazeSolver_SanityCheckTests, reportsNoWinnerWhenAllFail)
+{
+    std::unique_ptr<Maze> maze = MazeFactory{}.createMaze(4, 4);
+    maze->addAllWalls();
+
+    myPortfolioMazeSolver portfolio;
+    std::vector<Direction> path;
+    EXPECT_FALSE(portfolio.findPath(*maze, {0, 0}, {3, 3}, path));
+    EXPECT_EQ("", portfolio.getWinner());
+}
+
+
+TEST(myPortfolioMazeSolver_SanityCheckTests, rethrowsWhatAStrategyThrows)
+{
+    std::unique_ptr<Maze> maze = perfectMaze(10);
+    std::atomic<bool> otherStopped{false};
+
+    myPortfolioMazeSolver portfolio;
+    portfolio.clearStrategies();
+    portfolio.addStrategy("waits", [&](const Maze&, std::pair<int,int>, std::pair<int,int>,
+                                       std::vector<Direction>&, const std::atomic<bool>* cancel)
+    {
+        while (!cancel->load())
+        {
+        }
+        otherStopped = true;
+        return false;
+    });
+    portfolio.addStrategy("throws", [](const Maze&, std::pair<int,int>, std::pair<int,int>,
+                                       std::vector<Direction>&, const std::atomic<bool>*) -> bool
+    {
+        throw std::runtime_error{"broken strategy"};
+    });
+
+    std::vector<Direction> path;
+    EXPECT_THROW(portfolio.findPath(*maze, {0, 0}, {WIDTH-1, HEIGHT-1}, path), std::runtime_error);
+    EXPECT_TRUE(otherStopped);
+
+    // The next race starts afresh.
+    portfolio.clearStrategies();
+    portfolio.addStrategy("bfs", breadthFirst);
+    EXPECT_TRUE(portfolio.findPath(*maze, {0, 0}, {WIDTH-1, HEIGHT-1}, path));
+    EXPECT_EQ("bfs", portfolio.getWinner());
+}
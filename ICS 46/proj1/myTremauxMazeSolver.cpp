@@ -0,0 +1,64 @@
+#include "myTremauxMazeSolver.hpp"
+#include <ics46/factory/DynamicFactory.hpp>
+using namespace std;
+
+ICS46_DYNAMIC_FACTORY_REGISTER(MazeSolver, myTremauxMazeSolver, "Richard's Tremaux MazeSolver (junction marks)");
+
+void myTremauxMazeSolver::solveMaze(const Maze& maze, MazeSolution& mazeSolution)
+{
+    if (findPath(maze,mazeSolution.getStartingCell(),mazeSolution.getEndingCell(),path))
+    {
+        MazeSearch::writePath(path,mazeSolution);
+    }
+}
+
+long long myTremauxMazeSolver::getSteps() const
+{
+    return steps;
+}
+
+size_t myTremauxMazeSolver::getJunctionsMarked() const
+{
+    return marks.size();
+}
+
+size_t myTremauxMazeSolver::getMemoryBytes() const
+{
+    return marks.memoryBytes() + walk.memoryBytes();
+}
+
+void myTremauxMazeSolver::setMemoryLimit(size_t bytes)
+{
+    memoryLimit = bytes;
+}
+
+bool myTremauxMazeSolver::hitMemoryLimit() const
+{
+    return limitReached;
+}
+
+void myTremauxMazeSolver::setCancel(const atomic<bool>* cancel)
+{
+    this->cancel = cancel;
+}
+
+unsigned int myTremauxMazeSolver::marksOf(uint64_t cell,Direction direction) const
+{
+    const unsigned char* found = marks.find(cell);
+    if (found == nullptr)
+    {
+        return 0;
+    }
+    return (*found >> (2 * static_cast<int>(direction))) & 3;
+}
+
+// Marks saturate at two, which is all the algorithm tells apart.
+void myTremauxMazeSolver::mark(uint64_t cell,Direction direction)
+{
+    unsigned char& cellMarks = marks.get(cell);
+    int shift = 2 * static_cast<int>(direction);
+    if (((cellMarks >> shift) & 3) < 2)
+    {
+        cellMarks += 1 << shift;
+    }
+}
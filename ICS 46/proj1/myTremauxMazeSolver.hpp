@@ -0,0 +1,174 @@
+#ifndef MYTREMAUXMAZESOLVER_HPP
+#define MYTREMAUXMAZESOLVER_HPP
+
+#include "MazeSolver.hpp"
+#include "MazeSolution.hpp"
+#include "Direction.hpp"
+#include "Maze.hpp"
+#include "MazeSearch.hpp"
+#include "LoopErasedWalk.hpp"
+#include "CellTable.hpp"
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// Trémaux's algorithm: walk the corridors, and at every junction mark the
+// passage entered and the passage left.  A passage is never taken once
+// it has two marks, a new passage that leads back to a marked junction
+// is turned back from, and otherwise the least-marked way out is taken.
+// Unlike the wall follower this finds the end in any maze, loops and all,
+// and it stops with false once every passage from the start has two
+// marks.
+//
+// The marks are kept only for junctions (cells with three or more ways
+// out) and the start, in a CellTable, so corridors cost nothing.  Memory
+// still grows with the junctions visited, at about 7 to 13 bytes each.
+// That beats a visited grid only when the search stays in a small part of
+// a big maze.  In an Eller maze about one cell in eight is a junction, so
+// a search that covers the whole maze takes more than a byte per cell:
+// 43 MB on 5000x5000, against 3 MB for a BitGrid.  expmain --micro prints
+// both.  So it is a solver for searches that stay local, not a bounded-
+// memory one; setMemoryLimit() makes it stop cleanly instead of growing
+// without end.  Like the wall follower it runs on a Maze or directly on a
+// memory-mapped MazeBitboard, which must have fewer than 2^32 - 1 cells.
+class myTremauxMazeSolver: public MazeSolver
+{
+public:
+    void solveMaze(const Maze& maze, MazeSolution& mazeSolution) override;
+
+    template <typename Grid>
+    bool findPath(const Grid& grid,pair<int,int> start,pair<int,int> end,vector<Direction>& path);
+
+    // Moves made by the last search, and junctions it marked.
+    long long getSteps() const;
+    size_t getJunctionsMarked() const;
+
+    // What the last search's marks and route took up, in bytes.
+    size_t getMemoryBytes() const;
+
+    // setMemoryLimit() makes findPath() give up and return false once
+    // getMemoryBytes() passes bytes; 0, the default, means no limit.  It
+    // is checked along with cancellation, so a search stops soon after
+    // passing the limit rather than exactly at it.  hitMemoryLimit() says
+    // whether the last search stopped for that reason.
+    void setMemoryLimit(size_t bytes);
+    bool hitMemoryLimit() const;
+
+    // setCancel() makes findPath() give up and return false once *cancel
+    // turns true; pass nullptr to stop watching.
+    void setCancel(const atomic<bool>* cancel);
+
+private:
+    // A junction's marks are one byte, two bits for each way out, placed
+    // by the Direction's value.
+    unsigned int marksOf(uint64_t cell,Direction direction) const;
+    void mark(uint64_t cell,Direction direction);
+
+private:
+    CellTable<unsigned char> marks;
+    LoopErasedWalk walk;
+    vector<Direction> path;
+    long long steps = 0;
+    size_t memoryLimit = 0;
+    bool limitReached = false;
+    const atomic<bool>* cancel = nullptr;
+};
+
+
+template <typename Grid>
+bool myTremauxMazeSolver::findPath(const Grid& grid,pair<int,int> start,pair<int,int> end,vector<Direction>& path)
+{
+    CellTable<unsigned char>::check(grid.getWidth(),grid.getHeight());
+    path.clear();
+    marks.clear();
+    steps = 0;
+    limitReached = false;
+    int width = grid.getWidth();
+    walk.start(start.first,start.second,width);
+    int x = start.first;
+    int y = start.second;
+    bool arrived = false;
+    Direction heading = Direction::up;
+
+    while (x != end.first || y != end.second)
+    {
+        if (steps % MazeSearch::CANCEL_POLL_INTERVAL == 0 && MazeSearch::cancelled(cancel))
+        {
+            return false;
+        }
+        if (steps % MazeSearch::CANCEL_POLL_INTERVAL == 0 && memoryLimit > 0 && getMemoryBytes() > memoryLimit)
+        {
+            limitReached = true;
+            return false;
+        }
+
+        int exits = 0;
+        for (Direction direction : MazeSearch::directions)
+        {
+            exits += MazeSearch::canMove(grid,x,y,direction);
+        }
+        bool atStart = x == start.first && y == start.second;
+        Direction back = MazeSearch::opposite(heading);
+        Direction next;
+
+        if (!atStart && exits == 1)
+        {
+            next = back;
+        }
+        else if (!atStart && exits == 2)
+        {
+            next = back;
+            for (Direction direction : MazeSearch::directions)
+            {
+                if (direction != back && MazeSearch::canMove(grid,x,y,direction))
+                {
+                    next = direction;
+                }
+            }
+        }
+        else
+        {
+            uint64_t cell = static_cast<uint64_t>(y) * width + x;
+            bool seenBefore = marks.find(cell) != nullptr;
+            if (arrived)
+            {
+                mark(cell,back);
+            }
+
+            if (arrived && seenBefore && marksOf(cell,back) == 1)
+            {
+                next = back;
+            }
+            else
+            {
+                unsigned int fewest = 2;
+                next = back;
+                for (Direction direction : MazeSearch::directions)
+                {
+                    if (MazeSearch::canMove(grid,x,y,direction) && marksOf(cell,direction) < fewest)
+                    {
+                        fewest = marksOf(cell,direction);
+                        next = direction;
+                    }
+                }
+                if (fewest == 2)
+                {
+                    return false;
+                }
+            }
+            mark(cell,next);
+        }
+
+        MazeSearch::step(next,x,y);
+        walk.move(next);
+        heading = next;
+        arrived = true;
+        steps++;
+    }
+    path = walk.route();
+    return true;
+}
+
+#endif
@@ -0,0 +1,96 @@
+// myTremauxMazeSolver_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks that Trémaux's algorithm solves mazes with and without loops,
+// straight from a mapped bitboard file too, and stops cleanly at its
+// memory limit.
+
+#include <gtest/gtest.h>
+#include "myTremauxMazeSolver.hpp"
+#include "myEllerMazeGenerator.hpp"
+#include "MazeBitboard.hpp"
+#include "MazeSolutionFactory.hpp"
+#include "MazeSanityChecks.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace MazeSanityChecks;
+
+
+TEST(myTremauxMazeSolver_SanityCheckTests, solvesPerfectMazes)
+{
+    myTremauxMazeSolver solver;
+    for (uint64_t seed : {5, 6})
+    {
+        std::unique_ptr<Maze> maze = perfectMaze(seed);
+        std::unique_ptr<MazeSolution> solution = MazeSolutionFactory{}.createMazeSolution(WIDTH, HEIGHT);
+        solver.solveMaze(*maze, *solution);
+        EXPECT_TRUE(solvedCorrectly(*maze, *solution)) << "seed " << seed;
+    }
+}
+
+
+TEST(myTremauxMazeSolver_SanityCheckTests, solvesFromAMappedFile)
+{
+    std::string directory = temporaryDirectory("maze-Tremaux");
+    std::string path = directory + "/maze.bitboard";
+    {
+        myEllerMazeGenerator generator;
+        generator.setSeed(11);
+        MazeBitboardWriter writer{path, WIDTH, HEIGHT};
+        generator.generateRows(WIDTH, HEIGHT, writer);
+        writer.finish();
+    }
+    MazeBitboard bitboard = MazeBitboard::map(path);
+    std::unique_ptr<Maze> maze = MazeFactory{}.createMaze(WIDTH, HEIGHT);
+    bitboard.toMaze(*maze);
+
+    std::vector<Direction> route;
+    EXPECT_TRUE(myTremauxMazeSolver{}.findPath(bitboard, {0, 0}, {WIDTH-1, HEIGHT-1}, route));
+    EXPECT_TRUE(isRoute(*maze, {0, 0}, {WIDTH-1, HEIGHT-1}, route));
+    std::remove(path.c_str());
+    rmdir(directory.c_str());
+}
+
+
+TEST(myTremauxMazeSolver_SanityCheckTests, stopsAtItsMemoryLimit)
+{
+    myMazeGenerator generator;
+    generator.setSeed(28);
+    std::unique_ptr<Maze> maze = generated(generator, 300, 300);
+    myTremauxMazeSolver solver;
+    std::vector<Direction> route;
+
+    solver.setMemoryLimit(1);
+    EXPECT_FALSE(solver.findPath(*maze, {0, 0}, {299, 299}, route));
+    EXPECT_TRUE(solver.hitMemoryLimit());
+
+    solver.setMemoryLimit(0);
+    EXPECT_TRUE(solver.findPath(*maze, {0, 0}, {299, 299}, route));
+    EXPECT_FALSE(solver.hitMemoryLimit());
+    EXPECT_TRUE(isRoute(*maze, {0, 0}, {299, 299}, route));
+
+    solver.setMemoryLimit(solver.getMemoryBytes() * 2);
+    EXPECT_TRUE(solver.findPath(*maze, {0, 0}, {299, 299}, route));
+    EXPECT_FALSE(solver.hitMemoryLimit());
+}
+
+
+TEST(myTremauxMazeSolver_SanityCheckTests, findsTheEndThroughLoops)
+{
+    std::unique_ptr<Maze> maze = bandedMaze();
+    std::vector<Direction> route;
+    myTremauxMazeSolver solver;
+    EXPECT_TRUE(solver.findPath(*maze, {WIDTH/2, 0}, {0, HEIGHT-1}, route));
+    EXPECT_TRUE(isRoute(*maze, {WIDTH/2, 0}, {0, HEIGHT-1}, route));
+
+    std::unique_ptr<Maze> walled = MazeFactory{}.createMaze(4, 4);
+    walled->addAllWalls();
+    walled->removeWall(0, 0, Direction::right);
+    EXPECT_FALSE(solver.findPath(*walled, {0, 0}, {3, 3}, route));
+    EXPECT_FALSE(solver.hitMemoryLimit());
+}
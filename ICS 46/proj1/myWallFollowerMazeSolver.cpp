@@ -0,0 +1,38 @@
+#include "myWallFollowerMazeSolver.hpp"
+#include <ics46/factory/DynamicFactory.hpp>
+using namespace std;
+
+ICS46_DYNAMIC_FACTORY_REGISTER(MazeSolver, myWallFollowerMazeSolver, "Richard's Wall Follower MazeSolver (right-hand rule)");
+
+void myWallFollowerMazeSolver::solveMaze(const Maze& maze, MazeSolution& mazeSolution)
+{
+    if (findPath(maze,mazeSolution.getStartingCell(),mazeSolution.getEndingCell(),path))
+    {
+        MazeSearch::writePath(path,mazeSolution);
+    }
+}
+
+long long myWallFollowerMazeSolver::getSteps() const
+{
+    return steps;
+}
+
+size_t myWallFollowerMazeSolver::getMemoryBytes() const
+{
+    return walk.memoryBytes();
+}
+
+void myWallFollowerMazeSolver::setMemoryLimit(size_t bytes)
+{
+    memoryLimit = bytes;
+}
+
+bool myWallFollowerMazeSolver::hitMemoryLimit() const
+{
+    return limitReached;
+}
+
+void myWallFollowerMazeSolver::setCancel(const atomic<bool>* cancel)
+{
+    this->cancel = cancel;
+}
@@ -0,0 +1,119 @@
+#ifndef MYWALLFOLLOWERMAZESOLVER_HPP
+#define MYWALLFOLLOWERMAZESOLVER_HPP
+
+#include "MazeSolver.hpp"
+#include "MazeSolution.hpp"
+#include "Direction.hpp"
+#include "Maze.hpp"
+#include "MazeSearch.hpp"
+#include "LoopErasedWalk.hpp"
+#include <atomic>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// Keeps its right hand on the wall: at every cell it turns right if it
+// can, else goes straight, else left, else back.  Nothing is stored per
+// cell, so it can solve a maze too big for a visited grid, including a
+// memory-mapped MazeBitboard, which findPath() takes as readily as a
+// Maze.  The route comes out of a LoopErasedWalk, whose memory follows
+// the route's length, which setMemoryLimit() can cap.  The maze must have
+// fewer than 2^32 - 1 cells.
+//
+// In a perfect maze the walk goes round the whole tree if it has to, so
+// it always reaches the end.  In a maze with loops it can circle an
+// island forever; the walk is stopped, and findPath() returns false, when
+// it is about to repeat its first move.
+class myWallFollowerMazeSolver: public MazeSolver
+{
+public:
+    void solveMaze(const Maze& maze, MazeSolution& mazeSolution) override;
+
+    template <typename Grid>
+    bool findPath(const Grid& grid,pair<int,int> start,pair<int,int> end,vector<Direction>& path);
+
+    // Moves made by the last search, dead ends and all.
+    long long getSteps() const;
+
+    // What the last search's route took up, in bytes.
+    size_t getMemoryBytes() const;
+
+    // setMemoryLimit() makes findPath() give up and return false once
+    // getMemoryBytes() passes bytes; 0, the default, means no limit.  It
+    // is checked along with cancellation, so a search stops soon after
+    // passing the limit rather than exactly at it.  hitMemoryLimit() says
+    // whether the last search stopped for that reason.
+    void setMemoryLimit(size_t bytes);
+    bool hitMemoryLimit() const;
+
+    // setCancel() makes findPath() give up and return false once *cancel
+    // turns true; pass nullptr to stop watching.
+    void setCancel(const atomic<bool>* cancel);
+
+private:
+    LoopErasedWalk walk;
+    vector<Direction> path;
+    long long steps = 0;
+    size_t memoryLimit = 0;
+    bool limitReached = false;
+    const atomic<bool>* cancel = nullptr;
+};
+
+
+template <typename Grid>
+bool myWallFollowerMazeSolver::findPath(const Grid& grid,pair<int,int> start,pair<int,int> end,vector<Direction>& path)
+{
+    CellTable<uint32_t>::check(grid.getWidth(),grid.getHeight());
+    path.clear();
+    steps = 0;
+    limitReached = false;
+    walk.start(start.first,start.second,grid.getWidth());
+    int x = start.first;
+    int y = start.second;
+
+    // Facing up and turning right first, the first move is the first open
+    // direction clockwise from the left.
+    Direction heading = Direction::up;
+    Direction firstMove = Direction::up;
+    while (x != end.first || y != end.second)
+    {
+        Direction direction = MazeSearch::turnRight(heading);
+        int turns = 0;
+        while (turns < 4 && !MazeSearch::canMove(grid,x,y,direction))
+        {
+            direction = MazeSearch::turnLeft(direction);
+            turns++;
+        }
+        if (turns == 4)
+        {
+            return false;
+        }
+
+        if (steps == 0)
+        {
+            firstMove = direction;
+        }
+        else if (x == start.first && y == start.second && direction == firstMove)
+        {
+            return false;
+        }
+        if (steps % MazeSearch::CANCEL_POLL_INTERVAL == 0 && MazeSearch::cancelled(cancel))
+        {
+            return false;
+        }
+        if (steps % MazeSearch::CANCEL_POLL_INTERVAL == 0 && memoryLimit > 0 && getMemoryBytes() > memoryLimit)
+        {
+            limitReached = true;
+            return false;
+        }
+
+        MazeSearch::step(direction,x,y);
+        walk.move(direction);
+        heading = direction;
+        steps++;
+    }
+    path = walk.route();
+    return true;
+}
+
+#endif
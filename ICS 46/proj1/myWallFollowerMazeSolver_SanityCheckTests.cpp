@@ -0,0 +1,79 @@
+// myWallFollowerMazeSolver_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks that the wall follower solves perfect mazes, straight from a
+// mapped bitboard file too, and stops cleanly at its memory limit.
+
+#include <gtest/gtest.h>
+#include "myWallFollowerMazeSolver.hpp"
+#include "myEllerMazeGenerator.hpp"
+#include "MazeBitboard.hpp"
+#include "MazeSolutionFactory.hpp"
+#include "MazeSanityChecks.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace MazeSanityChecks;
+
+
+TEST(myWallFollowerMazeSolver_SanityCheckTests, solvesPerfectMazes)
+{
+    myWallFollowerMazeSolver solver;
+    for (uint64_t seed : {5, 6})
+    {
+        std::unique_ptr<Maze> maze = perfectMaze(seed);
+        std::unique_ptr<MazeSolution> solution = MazeSolutionFactory{}.createMazeSolution(WIDTH, HEIGHT);
+        solver.solveMaze(*maze, *solution);
+        EXPECT_TRUE(solvedCorrectly(*maze, *solution)) << "seed " << seed;
+    }
+}
+
+
+TEST(myWallFollowerMazeSolver_SanityCheckTests, solvesFromAMappedFile)
+{
+    std::string directory = temporaryDirectory("maze-WallFollower");
+    std::string path = directory + "/maze.bitboard";
+    {
+        myEllerMazeGenerator generator;
+        generator.setSeed(11);
+        MazeBitboardWriter writer{path, WIDTH, HEIGHT};
+        generator.generateRows(WIDTH, HEIGHT, writer);
+        writer.finish();
+    }
+    MazeBitboard bitboard = MazeBitboard::map(path);
+    std::unique_ptr<Maze> maze = MazeFactory{}.createMaze(WIDTH, HEIGHT);
+    bitboard.toMaze(*maze);
+
+    std::vector<Direction> route;
+    EXPECT_TRUE(myWallFollowerMazeSolver{}.findPath(bitboard, {0, 0}, {WIDTH-1, HEIGHT-1}, route));
+    EXPECT_TRUE(isRoute(*maze, {0, 0}, {WIDTH-1, HEIGHT-1}, route));
+    std::remove(path.c_str());
+    rmdir(directory.c_str());
+}
+
+
+TEST(myWallFollowerMazeSolver_SanityCheckTests, stopsAtItsMemoryLimit)
+{
+    myMazeGenerator generator;
+    generator.setSeed(28);
+    std::unique_ptr<Maze> maze = generated(generator, 300, 300);
+    myWallFollowerMazeSolver solver;
+    std::vector<Direction> route;
+
+    solver.setMemoryLimit(1);
+    EXPECT_FALSE(solver.findPath(*maze, {0, 0}, {299, 299}, route));
+    EXPECT_TRUE(solver.hitMemoryLimit());
+
+    solver.setMemoryLimit(0);
+    EXPECT_TRUE(solver.findPath(*maze, {0, 0}, {299, 299}, route));
+    EXPECT_FALSE(solver.hitMemoryLimit());
+    EXPECT_TRUE(isRoute(*maze, {0, 0}, {299, 299}, route));
+
+    solver.setMemoryLimit(solver.getMemoryBytes() * 2);
+    EXPECT_TRUE(solver.findPath(*maze, {0, 0}, {299, 299}, route));
+    EXPECT_FALSE(solver.hitMemoryLimit());
+}
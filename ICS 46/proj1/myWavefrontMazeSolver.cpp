@@ -0,0 +1,370 @@
+#include "myWavefrontMazeSolver.hpp"
+#include "MazeSearch.hpp"
+#include <ics46/factory/DynamicFactory.hpp>
+#include <algorithm>
+using namespace std;
+
+ICS46_DYNAMIC_FACTORY_REGISTER(MazeSolver, myWavefrontMazeSolver, "Richard's Wavefront MazeSolver (bit-parallel)");
+
+namespace
+{
+    // Occluded fills: spread the bits of seeds towards higher (or lower)
+    // bit positions through every position set in open, in six doubling
+    // steps instead of one step per bit.
+    uint64_t fillUp(uint64_t seeds,uint64_t open)
+    {
+        seeds |= open & (seeds << 1);
+        open &= open << 1;
+        seeds |= open & (seeds << 2);
+        open &= open << 2;
+        seeds |= open & (seeds << 4);
+        open &= open << 4;
+        seeds |= open & (seeds << 8);
+        open &= open << 8;
+        seeds |= open & (seeds << 16);
+        open &= open << 16;
+        seeds |= open & (seeds << 32);
+        return seeds;
+    }
+
+    uint64_t fillDown(uint64_t seeds,uint64_t open)
+    {
+        seeds |= open & (seeds >> 1);
+        open &= open >> 1;
+        seeds |= open & (seeds >> 2);
+        open &= open >> 2;
+        seeds |= open & (seeds >> 4);
+        open &= open >> 4;
+        seeds |= open & (seeds >> 8);
+        open &= open >> 8;
+        seeds |= open & (seeds >> 16);
+        open &= open >> 16;
+        seeds |= open & (seeds >> 32);
+        return seeds;
+    }
+}
+
+// The bitboard is built afresh every time: a Maze can change between
+// solves without telling anyone, so there is nothing safe to cache it by.
+void myWavefrontMazeSolver::solveMaze(const Maze& maze, MazeSolution& mazeSolution)
+{
+    MazeBitboard bitboard = MazeBitboard::fromMaze(maze);
+    if (findPath(bitboard,mazeSolution.getStartingCell(),mazeSolution.getEndingCell(),path))
+    {
+        MazeSearch::writePath(path,mazeSolution);
+    }
+}
+
+long long myWavefrontMazeSolver::getGenerations() const
+{
+    return generations;
+}
+
+bool myWavefrontMazeSolver::test(const vector<uint64_t>& plane,int x,int y) const
+{
+    return (plane[y * words + (x >> 6)] >> (x & 63)) & 1;
+}
+
+int myWavefrontMazeSolver::stepOf(int x,int y) const
+{
+    return test(stepLow,x,y) + 2 * test(stepHigh,x,y);
+}
+
+// Fills words [from, to) of next[] for row y with every unreached cell one
+// move away from the current frontier.
+void myWavefrontMazeSolver::expand(const MazeBitboard& bitboard,int y,size_t from,size_t to)
+{
+    int height = bitboard.getHeight();
+    const uint64_t* right = bitboard.rightWalls(y);
+    const uint64_t* down = bitboard.downWalls(y);
+    const uint64_t* above = y > 0 ? bitboard.downWalls(y-1) : nullptr;
+    const uint64_t* row = &frontier[y * words];
+    const uint64_t* rowAbove = y > 0 ? &frontier[(y-1) * words] : nullptr;
+    const uint64_t* rowBelow = y+1 < height ? &frontier[(y+1) * words] : nullptr;
+    uint64_t* out = &next[y * words];
+    const uint64_t* seen = &reached[y * words];
+
+    uint64_t carryRight = from > 0 ? (row[from-1] & ~right[from-1]) >> 63 : 0;
+    for (size_t w = from; w < to; w++)
+    {
+        uint64_t movesRight = row[w] & ~right[w];
+        uint64_t toRight = (movesRight << 1) | carryRight;
+        carryRight = movesRight >> 63;
+
+        uint64_t shiftedLeft = (row[w] >> 1) | (w+1 < words ? row[w+1] << 63 : 0);
+        uint64_t toLeft = shiftedLeft & ~right[w];
+
+        uint64_t toDown = rowAbove != nullptr ? rowAbove[w] & ~above[w] : 0;
+        uint64_t toUp = rowBelow != nullptr ? rowBelow[w] & ~down[w] : 0;
+
+        out[w] = (toRight | toLeft | toDown | toUp) & ~seen[w];
+    }
+}
+
+// Spreads next[] for row y sideways through open walls into unreached
+// cells: first leftwards from the high words down, then rightwards, each
+// carrying one bit across word boundaries and running past the span for
+// as long as the carry keeps going.
+void myWavefrontMazeSolver::flood(const MazeBitboard& bitboard,int y)
+{
+    const uint64_t* right = bitboard.rightWalls(y);
+    uint64_t* row = &next[y * words];
+    const uint64_t* seen = &reached[y * words];
+
+    // Bit x of enterFromRight: cell x is unreached and the wall between it
+    // and x+1 is open.  Bit x of enterFromLeft: the same with x-1.
+    size_t from = nextFrom[y];
+    size_t to = nextTo[y];
+    uint64_t carry = 0;
+    for (size_t w = to; w-- > 0; )
+    {
+        if (w < from && carry == 0)
+        {
+            break;
+        }
+        uint64_t enterFromRight = ~right[w] & ~seen[w];
+        uint64_t seeds = row[w] | (carry & enterFromRight & (uint64_t{1} << 63));
+        row[w] = fillDown(seeds, enterFromRight);
+        carry = (row[w] & 1) << 63;
+        from = min(from, w);
+    }
+
+    carry = 0;
+    for (size_t w = from; w < words; w++)
+    {
+        if (w >= to && carry == 0)
+        {
+            break;
+        }
+        uint64_t leftOpen = ~(right[w] << 1) & ~(w > 0 ? right[w-1] >> 63 : 1);
+        uint64_t enterFromLeft = leftOpen & ~seen[w];
+        uint64_t seeds = row[w] | (carry & enterFromLeft);
+        row[w] = fillUp(seeds, enterFromLeft);
+        carry = row[w] >> 63;
+        to = max(to, w + 1);
+    }
+
+    nextFrom[y] = from;
+    nextTo[y] = to;
+}
+
+bool myWavefrontMazeSolver::findPath(const MazeBitboard& bitboard,pair<int,int> start,pair<int,int> end,vector<Direction>& path)
+{
+    int height = bitboard.getHeight();
+    words = bitboard.rowWords();
+    size_t total = words * height;
+    reached.assign(total, 0);
+    frontier.assign(total, 0);
+    next.assign(total, 0);
+    stepLow.assign(total, 0);
+    stepHigh.assign(total, 0);
+    rowStamp.assign(height, -1);
+    spanFrom.assign(height, 0);
+    spanTo.assign(height, 0);
+    nextFrom.assign(height, 0);
+    nextTo.assign(height, 0);
+    generations = 0;
+
+    // Step 0 is the start cell flooded along its own row.
+    size_t startWord = start.first >> 6;
+    next[start.second * words + startWord] = uint64_t{1} << (start.first & 63);
+    nextFrom[start.second] = startWord;
+    nextTo[start.second] = startWord + 1;
+    touchedRows.assign(1, start.second);
+    activeRows.clear();
+
+    while (true)
+    {
+        for (int y : touchedRows)
+        {
+            flood(bitboard,y);
+        }
+
+        for (int row : activeRows)
+        {
+            fill(frontier.begin() + row * words + spanFrom[row],
+                 frontier.begin() + row * words + spanTo[row], 0);
+        }
+
+        // The step number mod 3 is written as two bits: low for 1, high
+        // for 2.
+        int modulo = generations % 3;
+        activeRows.clear();
+        for (int y : touchedRows)
+        {
+            size_t first = words;
+            size_t last = 0;
+            for (size_t w = nextFrom[y]; w < nextTo[y]; w++)
+            {
+                size_t i = y * words + w;
+                uint64_t gained = next[i];
+                if (gained == 0)
+                {
+                    continue;
+                }
+                next[i] = 0;
+                reached[i] |= gained;
+                frontier[i] = gained;
+                stepLow[i] |= modulo == 1 ? gained : 0;
+                stepHigh[i] |= modulo == 2 ? gained : 0;
+                first = min(first, w);
+                last = w + 1;
+            }
+            if (last > 0)
+            {
+                activeRows.push_back(y);
+                spanFrom[y] = first;
+                spanTo[y] = last;
+            }
+        }
+
+        if (test(reached,end.first,end.second))
+        {
+            break;
+        }
+        if (activeRows.empty())
+        {
+            return false;
+        }
+        generations++;
+
+        // Rows that can gain cells this step are the active rows and their
+        // neighbours, each listed once, over the union of the spans next
+        // to them widened by a word for moves across a word boundary.
+        touchedRows.clear();
+        for (int row : activeRows)
+        {
+            size_t from = spanFrom[row] > 0 ? spanFrom[row] - 1 : 0;
+            size_t to = min(words, spanTo[row] + 1);
+            for (int y = max(0, row-1); y <= min(height-1, row+1); y++)
+            {
+                if (rowStamp[y] != generations)
+                {
+                    rowStamp[y] = generations;
+                    touchedRows.push_back(y);
+                    nextFrom[y] = from;
+                    nextTo[y] = to;
+                }
+                else
+                {
+                    nextFrom[y] = min(nextFrom[y], from);
+                    nextTo[y] = max(nextTo[y], to);
+                }
+            }
+        }
+
+        for (int y : touchedRows)
+        {
+            expand(bitboard,y,nextFrom[y],nextTo[y]);
+        }
+    }
+
+    return traceBack(bitboard,start,end,path);
+}
+
+// Collects the moves backwards, from the goal to the start, and reverses
+// them at the end.  step is the exact step number of the current cell.
+// Every reached cell past the start touches a cell of the step before, so
+// the walk can't get stuck; if a broken frontier ever breaks that, it
+// returns false with an empty path rather than a partial one.
+bool myWavefrontMazeSolver::traceBack(const MazeBitboard& bitboard,pair<int,int> start,pair<int,int> end,vector<Direction>& path)
+{
+    path.clear();
+    int width = bitboard.getWidth();
+    int height = bitboard.getHeight();
+    int x = end.first;
+    int y = end.second;
+    long long step = generations;
+
+    auto earlierNeighbour = [&](int cx,int cy,Direction& found)
+    {
+        int earlier = static_cast<int>((step + 2) % 3);
+        for (Direction direction : MazeSearch::directions)
+        {
+            int xc = cx;
+            int yc = cy;
+            MazeSearch::step(direction,xc,yc);
+            if (xc >= 0 && yc >= 0 && xc < width && yc < height
+                && !bitboard.wallExists(cx,cy,direction)
+                && test(reached,xc,yc) && stepOf(xc,yc) == earlier)
+            {
+                found = direction;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // Whether the row neighbour of (cx, cy) on the given side is open and
+    // was reached in the same step, i.e. the run of this step goes on.
+    auto inRun = [&](int cx,int cy,Direction direction)
+    {
+        int xc = cx;
+        int yc = cy;
+        MazeSearch::step(direction,xc,yc);
+        return xc >= 0 && xc < width && !bitboard.wallExists(cx,cy,direction)
+            && test(reached,xc,cy) && stepOf(xc,cy) == step % 3;
+    };
+
+    while (step > 0)
+    {
+        // Find the nearest cell of this run, on either side, that touches
+        // the step before, then walk there and take that move.
+        Direction found = Direction::up;
+        int target = -1;
+        for (int distance = 0; target < 0; distance++)
+        {
+            bool any = false;
+            for (Direction side : {Direction::left, Direction::right})
+            {
+                int cx = x;
+                bool ok = true;
+                for (int i = 0; i < distance && ok; i++)
+                {
+                    ok = inRun(cx,y,side);
+                    MazeSearch::step(side,cx,y);
+                }
+                if (!ok)
+                {
+                    continue;
+                }
+                any = true;
+                if (earlierNeighbour(cx,y,found))
+                {
+                    target = cx;
+                    break;
+                }
+            }
+            if (!any)
+            {
+                path.clear();
+                return false;
+            }
+        }
+
+        Direction side = target < x ? Direction::left : Direction::right;
+        while (x != target)
+        {
+            path.push_back(MazeSearch::opposite(side));
+            MazeSearch::step(side,x,y);
+        }
+        path.push_back(MazeSearch::opposite(found));
+        MazeSearch::step(found,x,y);
+        step--;
+    }
+
+    // Step 0 is the start's own row, flooded from the start.
+    if (y != start.second)
+    {
+        path.clear();
+        return false;
+    }
+    Direction side = start.first < x ? Direction::left : Direction::right;
+    while (x != start.first)
+    {
+        path.push_back(MazeSearch::opposite(side));
+        MazeSearch::step(side,x,y);
+    }
+    reverse(path.begin(), path.end());
+    return true;
+}
@@ -0,0 +1,75 @@
+#ifndef MYWAVEFRONTMAZESOLVER_HPP
+#define MYWAVEFRONTMAZESOLVER_HPP
+
+#include "MazeSolver.hpp"
+#include "MazeSolution.hpp"
+#include "MazeBitboard.hpp"
+#include "Direction.hpp"
+#include "Maze.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// A wavefront search done 64 cells at a time on a MazeBitboard.  The
+// reached set and the frontier are bitsets laid out like the wall planes.
+// Each step first moves the frontier one cell in every direction (shifts
+// masked with the right walls, rows ANDed with the down walls between
+// them), then floods the new cells along their rows as far as the walls
+// allow, with a log-step shift-and-mask fill inside each word and a carry
+// between words.  A corridor running along a row is therefore crossed in
+// one step, so the number of steps follows the number of turns in the
+// route rather than its length.  Each frontier row remembers the span of
+// words it occupies, and only those spans and the rows next to them are
+// touched.
+//
+// Every reached cell also keeps its step number mod 3 in two bit planes.
+// Walking back from the goal, a cell either has an open neighbour from the
+// step before, or lies on a run of its own step's cells that was flooded
+// sideways from one that does.  Because of the sideways flooding the route
+// is a valid one but need not be the shortest.
+//
+// The speedup over breadth-first search is for findPath() on a bitboard
+// the caller already has, such as one mapped from a file.  solveMaze()
+// has to copy the Maze's walls into a new bitboard first, one virtual
+// wallExists() call at a time, and on an open 4000x4000 maze that copy
+// takes several times longer than the search does.
+class myWavefrontMazeSolver: public MazeSolver
+{
+public:
+    void solveMaze(const Maze& maze, MazeSolution& mazeSolution) override;
+    bool findPath(const MazeBitboard& bitboard,pair<int,int> start,pair<int,int> end,vector<Direction>& path);
+
+    // Wavefront steps taken by the last search.
+    long long getGenerations() const;
+
+private:
+    bool test(const vector<uint64_t>& plane,int x,int y) const;
+    int stepOf(int x,int y) const;
+    void expand(const MazeBitboard& bitboard,int y,size_t from,size_t to);
+    void flood(const MazeBitboard& bitboard,int y);
+    bool traceBack(const MazeBitboard& bitboard,pair<int,int> start,pair<int,int> end,vector<Direction>& path);
+
+private:
+    size_t words = 0;
+    vector<uint64_t> reached;
+    vector<uint64_t> frontier;
+    vector<uint64_t> next;
+    vector<uint64_t> stepLow;
+    vector<uint64_t> stepHigh;
+    vector<int> activeRows;
+    vector<int> touchedRows;
+    vector<long long> rowStamp;
+
+    // Words [spanFrom[y], spanTo[y]) of frontier row y may be non-zero;
+    // the same for next[] while a step is being built.
+    vector<size_t> spanFrom;
+    vector<size_t> spanTo;
+    vector<size_t> nextFrom;
+    vector<size_t> nextTo;
+
+    vector<Direction> path;
+    long long generations = 0;
+};
+
+#endif
@@ -0,0 +1,66 @@
+// myWavefrontMazeSolver_SanityCheckTests.cpp
+//
+// ICS 46 Spring 2020
+// Project #1: Dark at the End of the Tunnel
+//
+// Checks that the wavefront solver's routes are real routes, on mazes
+// wide enough that the wavefront crosses from one 64-bit word to the next.
+
+#include <gtest/gtest.h>
+#include "myWavefrontMazeSolver.hpp"
+#include "MazeSolutionFactory.hpp"
+#include "MazeSanityChecks.hpp"
+#include <vector>
+
+using namespace MazeSanityChecks;
+
+
+TEST(myWavefrontMazeSolver_SanityCheckTests, solvesPerfectMazes)
+{
+    myWavefrontMazeSolver solver;
+    for (int width : {WIDTH, 130})
+    {
+        myMazeGenerator generator;
+        generator.setSeed(width);
+        std::unique_ptr<Maze> maze = generated(generator, width, HEIGHT);
+        std::unique_ptr<MazeSolution> solution = MazeSolutionFactory{}.createMazeSolution(width, HEIGHT);
+        solver.solveMaze(*maze, *solution);
+        EXPECT_TRUE(solvedCorrectly(*maze, *solution)) << "width " << width;
+    }
+}
+
+
+// Flooding along rows can leave the route longer than the shortest one,
+// but never shorter.
+TEST(myWavefrontMazeSolver_SanityCheckTests, findsARouteThroughLoops)
+{
+    std::unique_ptr<Maze> maze = bandedMaze();
+    MazeBitboard bitboard = MazeBitboard::fromMaze(*maze);
+    std::vector<Direction> path;
+    myWavefrontMazeSolver solver;
+    EXPECT_TRUE(solver.findPath(bitboard, {0, 0}, {WIDTH-1, HEIGHT-1}, path));
+    EXPECT_TRUE(isRoute(*maze, {0, 0}, {WIDTH-1, HEIGHT-1}, path));
+    EXPECT_GE(path.size(), static_cast<size_t>(WIDTH + HEIGHT - 2));
+    EXPECT_TRUE(solver.findPath(bitboard, {WIDTH-1, HEIGHT-1}, {5, 0}, path));
+    EXPECT_TRUE(isRoute(*maze, {WIDTH-1, HEIGHT-1}, {5, 0}, path));
+}
+
+
+TEST(myWavefrontMazeSolver_SanityCheckTests, crossesOpenRowsInOneStep)
+{
+    std::unique_ptr<Maze> maze = MazeFactory{}.createMaze(200, 1);
+    maze->removeAllWalls();
+    std::vector<Direction> path;
+    myWavefrontMazeSolver solver;
+    EXPECT_TRUE(solver.findPath(MazeBitboard::fromMaze(*maze), {0, 0}, {199, 0}, path));
+    EXPECT_TRUE(isRoute(*maze, {0, 0}, {199, 0}, path));
+    EXPECT_LE(solver.getGenerations(), 2);
+}
+
+
+TEST(myWavefrontMazeSolver_SanityCheckTests, reportsAnUnreachableEnd)
+{
+    MazeBitboard bitboard{70, 4};
+    std::vector<Direction> path;
+    EXPECT_FALSE(myWavefrontMazeSolver{}.findPath(bitboard, {0, 0}, {69, 3}, path));
+}